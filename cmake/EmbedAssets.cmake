@@ -0,0 +1,36 @@
+# Generates a C++ source holding every file under fonts/ and images/ as a
+# byte array, looked up by its path relative to the source tree.
+#
+#   cmake -DROOT=<source dir> -DOUTPUT=<generated .cpp> -P EmbedAssets.cmake
+
+file(GLOB_RECURSE ASSET_FILES RELATIVE "${ROOT}"
+    "${ROOT}/fonts/*"
+    "${ROOT}/images/*"
+)
+list(SORT ASSET_FILES)
+
+set(content "// Generated by cmake/EmbedAssets.cmake - do not edit\n")
+string(APPEND content "#include \"EmbeddedAssets.h\"\n\n")
+
+string(REPEAT "0x[0-9a-f][0-9a-f]," 32 linePattern)
+
+set(table "")
+set(index 0)
+foreach(asset IN LISTS ASSET_FILES)
+    file(READ "${ROOT}/${asset}" hex HEX)
+    string(LENGTH "${hex}" hexLength)
+    math(EXPR size "${hexLength} / 2")
+
+    # 32 bytes per line (CMake regexes have no {n} repeat count)
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+    string(REGEX REPLACE "(${linePattern})" "\\1\n" bytes "${bytes}")
+
+    string(APPEND content "static const unsigned char asset${index}[] = {\n${bytes}\n};\n\n")
+    string(APPEND table "    {\"${asset}\", asset${index}, ${size}},\n")
+    math(EXPR index "${index} + 1")
+endforeach()
+
+string(APPEND content "const EmbeddedAsset embeddedAssets[] = {\n${table}};\n\n")
+string(APPEND content "const std::size_t embeddedAssetCount = ${index};\n")
+
+file(WRITE "${OUTPUT}" "${content}")
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Board.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+
+// Latest analysis of one position. Scores are from White's point of view.
+struct AnalysisInfo {
+    uint64_t positionKey = 0;
+    int depth = 0;
+    uint64_t nodes = 0;        // main thread only
+    std::vector<SearchLine> lines;
+};
+
+// Infinite analysis of the current position on background threads. One
+// thread reports multi-PV lines after each completed depth; the helpers
+// search the same position single-PV and only feed the shared table.
+// start() on a new position stops the old search but keeps the table, so
+// analysis after a move picks up where the previous one left off.
+//
+// With a snapshot path the table is restored from it (if the file exists)
+// and saved back when the analyzer is destroyed, so the next session
+// starts with everything this one searched. Both run on a background
+// thread, in order, so neither blocks the caller; the search threads wait
+// for the load before they start.
+class Analyzer {
+public:
+    Analyzer(int threads = 2, int multiPv = 3, size_t hashMb = 64,
+             std::string snapshotPath = "");
+    ~Analyzer();
+
+    Analyzer(const Analyzer&) = delete;
+    Analyzer& operator=(const Analyzer&) = delete;
+
+    void start(const Board& position);
+    void stop();
+    bool isRunning() const { return !workers.empty(); }
+
+    // Copies the latest info if it changed since the previous call.
+    // Never waits on the search beyond a short lock.
+    bool poll(AnalysisInfo& info);
+
+private:
+    void publish(const Board& position, const SearchResult& result);
+
+    int threads;
+    int multiPv;
+    std::string snapshotPath;
+    std::shared_ptr<TranspositionTable> tt;
+    std::shared_future<void> snapshotLoaded;   // invalid without a snapshot
+
+    std::atomic<bool> stopFlag{false};
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    AnalysisInfo latest;
+    uint64_t version = 0;
+    uint64_t polledVersion = 0;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "Analysis.h"
+
+// Draws analysis results: an evaluation bar beside the board, an arrow
+// on the board for the first move of each line, and the lines as text.
+// With no info it only draws the empty bar, plus a hint where analysis
+// can be switched on.
+class AnalysisView {
+public:
+    AnalysisView(float tileSize, sf::FloatRect barArea, sf::FloatRect linesArea,
+                 bool analysisAvailable);
+
+    void draw(sf::RenderTarget& target, const AnalysisInfo* info) const;
+
+private:
+    void drawBar(sf::RenderTarget& target, const AnalysisInfo* info) const;
+    void drawArrow(sf::RenderTarget& target, const Move& move, sf::Color color) const;
+    void drawLines(sf::RenderTarget& target, const AnalysisInfo* info) const;
+
+    sf::Vector2f squareCenter(int square) const;
+
+    float tileSize;
+    sf::FloatRect barArea;
+    sf::FloatRect linesArea;
+    bool analysisAvailable;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <SFML/Graphics.hpp>
+
+// Process-wide cache of GUI assets. Each texture, image and font is loaded
+// on first use and kept for the life of the process, so windows and
+// render loops can ask for them freely. Paths are relative to the source
+// tree ("fonts/font.ttf"); with CHESS_EMBED_ASSETS the bytes come from
+// the binary itself and the working directory does not matter.
+// Failures throw std::runtime_error.
+class Assets {
+public:
+    static Assets& instance();
+
+    const sf::Texture& texture(const std::string& path);
+    const sf::Image& image(const std::string& path);
+    const sf::Font& font(const std::string& path);
+
+private:
+    Assets() = default;
+
+    // Embedded bytes for path, or false to fall back to the file system
+    static bool findEmbedded(const std::string& path, const void*& data, std::size_t& size);
+
+    // References stay valid: node-based maps never move their values
+    std::unordered_map<std::string, sf::Texture> textures;
+    std::unordered_map<std::string, sf::Image> images;
+    std::unordered_map<std::string, sf::Font> fonts;
+};
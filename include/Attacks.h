@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Piece.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Per-square attack sets for the pieces whose reach doesn't depend on
+// other pieces, as 64-bit masks (bit n = square n, a1 = 0). Built at
+// compile time; the wrap-around filtering happens here once instead of
+// in every generation and attack loop.
+namespace attacks {
+
+using Table = std::array<uint64_t, 64>;
+
+constexpr Table leaperTable(const int (&steps)[8][2]) {
+    Table table{};
+    for (int square = 0; square < 64; ++square) {
+        int rank = square / 8;
+        int file = square % 8;
+        for (const auto& step : steps) {
+            int r = rank + step[0];
+            int f = file + step[1];
+            if (r >= 0 && r < 8 && f >= 0 && f < 8)
+                table[square] |= 1ULL << (r * 8 + f);
+        }
+    }
+    return table;
+}
+
+constexpr int knightSteps[8][2] = {
+    {2, 1}, {2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}, {-2, 1}, {-2, -1}
+};
+
+constexpr int kingSteps[8][2] = {
+    {1, 0}, {1, 1}, {1, -1}, {0, 1}, {0, -1}, {-1, 0}, {-1, 1}, {-1, -1}
+};
+
+constexpr Table pawnTable(int forward) {
+    Table table{};
+    for (int square = 0; square < 64; ++square) {
+        int r = square / 8 + forward;
+        int file = square % 8;
+        if (r < 0 || r > 7)
+            continue;
+        if (file > 0) table[square] |= 1ULL << (r * 8 + file - 1);
+        if (file < 7) table[square] |= 1ULL << (r * 8 + file + 1);
+    }
+    return table;
+}
+
+inline constexpr Table knight = leaperTable(knightSteps);
+inline constexpr Table king = leaperTable(kingSteps);
+
+// Squares a pawn of the given colour attacks, indexed by Color
+inline constexpr std::array<Table, 2> pawn = {pawnTable(1), pawnTable(-1)};
+
+inline int lsb(uint64_t bb) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bb);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bb);
+#endif
+}
+
+inline int popCount(uint64_t bb) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(bb));
+#else
+    return __builtin_popcountll(bb);
+#endif
+}
+
+// Lowest set square, removed from the mask
+inline int popLsb(uint64_t& bb) {
+    int square = lsb(bb);
+    bb &= bb - 1;
+    return square;
+}
+
+} // namespace attacks
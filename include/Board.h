@@ -2,31 +2,66 @@
 
 #include <array>
 #include <vector>
+#include <string>
 #include "Piece.h"
 #include "Move.h"
 #include <cstdint>
 
+enum CastlingRight : uint8_t {
+    WHITE_KINGSIDE  = 1,
+    WHITE_QUEENSIDE = 2,
+    BLACK_KINGSIDE  = 4,
+    BLACK_QUEENSIDE = 8
+};
+
+// Which pseudo-legal moves to generate. CAPTURES also holds promotions
+// and en passant; QUIETS is everything else, castling included.
+enum class GenType {
+    ALL,
+    CAPTURES,
+    QUIETS
+};
+
 class Board {
 public:
     Board();
 
+    bool loadFen(const std::string& fen);
+    std::string toFen() const;
+
     Piece getPiece(int square) const;
     void setPiece(int square, Piece p);
     bool isEmpty(int square) const;
     void print() const;
     std::vector<Move> pseudoLegalMoves(Color side) const;
+    void generateMoves(GenType type, std::vector<Move>& moves) const;   // side to move, appends
+    bool lookupMove(int from, int to, Move& move) const;   // full move if pseudo-legal
     bool squareAttacked(int square, Color by) const;
+    uint64_t attackedSquares(Color by) const;   // bit per square, cached until the next move
     bool kingInCheck(Color side) const;
+    int kingSquare(Color side) const { return kingSquares[static_cast<int>(side)]; }
     std::vector<Move> legalMoves(Color side);
+    int countLegalMoves();   // side to move; builds and makes no moves
     void makeMove(Move m);
-    void applyMove(Move m);
+    void applyMove(Move& m);
     void undoMove(const Move& m);
+    void makeNullMove(Move& m);         // pass the turn; m keeps what undo needs
+    void undoNullMove(const Move& m);
+    void reserveHistory(size_t plies) { hashHistory.reserve(hashHistory.size() + plies); }
     uint64_t perft(int depth);
     uint64_t perftDivide(int depth);
     std::string moveToString(const Move& m);
     bool isCheckmate(Color side) const;
     bool isStalemate(Color side) const;
     Color getSideToMove() const { return sideToMove; }
+    uint8_t castlingRights() const;   // bit 0 K, 1 Q, 2 k, 3 q
+    int enPassantSquare() const;      // -1 if none
+
+    uint64_t hashKey() const { return hash; }   // Zobrist key of the position
+    uint64_t pawnKey() const { return pawnHash; }   // Zobrist key of the pawns alone
+    int getHalfmoveClock() const { return halfmoveClock; }
+    int repetitionCount() const;   // earlier occurrences since the last irreversible move
+    bool isFiftyMoveDraw() const { return halfmoveClock >= 100; }
 
     void undoLastMove();
     void redoLastMove();
@@ -38,12 +73,32 @@ private:
 
     std::array<Piece, 64> squares;
 
-    void addKnightMoves(int square, Color side, std::vector<Move>& moves) const;
-    void addPawnMoves(int square, Color side, std::vector<Move>& moves) const;
-    void addBishopMoves(int square, Color side, std::vector<Move>& moves) const;
-    void addRookMoves(int square, Color side, std::vector<Move>& moves) const;
-    void addQueenMoves(int square, Color side, std::vector<Move>& moves) const;
-    void addKingMoves(int square, Color side, std::vector<Move>& moves) const;
+    // The public entry points pick the colour once; everything below
+    // them runs with the side to move fixed at compile time.
+    template <Color Us, GenType Type> void pseudoLegalMovesFor(std::vector<Move>& moves) const;
+    template <Color Us> void legalMovesFor(std::vector<Move>& moves);
+    template <Color By> bool squareAttackedBy(int square) const;
+    template <Color Us> bool kingInCheckFor() const;
+    template <Color Us> void applyMoveFor(Move& m);
+    template <Color Us> void undoMoveFor(const Move& m);
+    template <Color Us> uint64_t perftFor(int depth);
+    template <Color Us> int countLegalMovesFor();
+    template <Color Us> bool canCastleKingside() const;
+    template <Color Us> bool canCastleQueenside() const;
+
+    template <Color Us, GenType Type> void addPieceMoves(int square, PieceType type, std::vector<Move>& moves) const;
+    template <Color Us, GenType Type> void addPawnMoves(int square, std::vector<Move>& moves) const;
+    template <Color Us, GenType Type> void addKnightMoves(int square, std::vector<Move>& moves) const;
+    template <Color Us, GenType Type> void addBishopMoves(int square, std::vector<Move>& moves) const;
+    template <Color Us, GenType Type> void addRookMoves(int square, std::vector<Move>& moves) const;
+    template <Color Us, GenType Type> void addQueenMoves(int square, std::vector<Move>& moves) const;
+    template <Color Us, GenType Type> void addKingMoves(int square, std::vector<Move>& moves) const;
+
+    uint64_t computeAttacks(Color by, int ignoreSquare = -1) const;   // ignoreSquare never blocks
+    void invalidateAttacks();
+    uint64_t computeHash() const;
+    int hashedEnPassantSquare() const;   // -1 unless the side to move can take e.p.
+    uint64_t computePawnHash() const;
 
     int lastMoveFrom = -1;
     int lastMoveTo = -1;
@@ -58,6 +113,17 @@ private:
 
     Color sideToMove;
 
+    std::array<int, 2> kingSquares = {4, 60};   // indexed by Color
+
+    uint64_t hash = 0;
+    uint64_t pawnHash = 0;   // kept by setPiece, so undo restores it too
+    int halfmoveClock = 0;
+    std::vector<uint64_t> hashHistory;   // key before each applied move
+
+    // Lazily computed per side, dropped on every board change
+    mutable std::array<uint64_t, 2> attackMaps = {0, 0};
+    mutable std::array<bool, 2> attackMapsValid = {false, false};
+
     std::vector<Move> pastMoves;   // undo stack
     std::vector<Move> futureMoves;
 };
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Board.h"
+#include "Move.h"
+
+// Draws the board, square highlights and pieces in two draw calls: one
+// textured quad for the board image, and one vertex array over a single
+// atlas holding all 12 piece images plus a white patch for the untextured
+// highlight quads. The vertex array is only rebuilt when the position or
+// the selection changes.
+class BoardRenderer {
+public:
+    explicit BoardRenderer(float tileSize);
+
+    // Takes images/board.png and images/pieces/*.png from the asset cache
+    // and packs the pieces into the atlas.
+    bool loadTextures(const std::string& imageDir = "images");
+
+    // Cheap when nothing changed: compares the position key and selection.
+    void update(const Board& board, int selectedSquare, const std::vector<Move>& selectedMoves);
+
+    void draw(sf::RenderTarget& target) const;
+
+private:
+    void rebuild(const Board& board, int selectedSquare, const std::vector<Move>& selectedMoves);
+    void appendQuad(sf::Vector2f position, sf::Vector2f size,
+                    sf::Vector2f texPosition, sf::Vector2f texSize, sf::Color color);
+    sf::Vector2f squareOrigin(int square) const;
+
+    static int pieceIndex(Piece p);
+
+    float tileSize;
+
+    const sf::Texture* boardTexture = nullptr;   // owned by Assets
+    sf::VertexArray boardQuad;
+
+    sf::Texture atlas;
+    std::array<sf::IntRect, 12> pieceRects;
+    sf::Vector2f whiteTexel;
+
+    sf::VertexArray vertices;
+
+    bool built = false;
+    uint64_t builtKey = 0;
+    int builtSelection = -1;
+};
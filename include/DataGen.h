@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "Search.h"
+
+// One labelled training position in a fixed 40-byte little-endian record:
+//
+//   bytes  0-31  board, one nibble per square, a1 first (low nibble = even square)
+//                0 empty, 1-6 white pawn/rook/knight/bishop/queen/king, 9-14 black
+//   bytes 32-33  search score in centipawns, White's point of view (int16)
+//   byte  34     game result, White's point of view: 1 win, 0 draw, -1 loss (int8)
+//   byte  35     side to move: 0 white, 1 black
+//   byte  36     castling rights (CastlingRight bits)
+//   byte  37     en passant square, 64 if none
+//   bytes 38-39  reserved, zero
+//
+// Files have no header, so shards can be concatenated, split on any
+// multiple of RECORD_SIZE and read back with plain sequential reads.
+struct PackedPosition {
+    static constexpr size_t RECORD_SIZE = 40;
+
+    std::array<uint8_t, 32> squares{};
+    int16_t score = 0;
+    int8_t result = 0;
+    uint8_t sideToMove = 0;
+    uint8_t castling = 0;
+    uint8_t epSquare = 64;
+
+    static PackedPosition fromBoard(const Board& board, int whiteScore);
+
+    void encode(uint8_t* out) const;
+    static PackedPosition decode(const uint8_t* in);
+
+    Piece pieceAt(int square) const;
+};
+
+// Buffers records in memory and appends them to one shard file in
+// large blocks. Each generator thread owns one writer.
+class PositionWriter {
+public:
+    explicit PositionWriter(const std::string& path, size_t bufferRecords = 8192);
+    ~PositionWriter();
+
+    // write and flush are false once the file could not take the data
+    // (full disk, removed directory); the shard is incomplete from then on
+    bool isOpen() const { return out.is_open(); }
+    bool write(const PackedPosition& position);
+    bool flush();
+
+private:
+    std::ofstream out;
+    std::vector<uint8_t> buffer;
+    size_t capacity;
+};
+
+// Sequential reader for a shard written by PositionWriter.
+class PositionReader {
+public:
+    explicit PositionReader(const std::string& path);
+
+    bool next(PackedPosition& position);
+
+private:
+    std::ifstream in;
+};
+
+struct DataGenConfig {
+    SearchConfig search;
+
+    uint64_t positions = 1000000;  // total across all threads
+    int threads = 0;               // 0 = one worker per hardware thread
+    int randomPlies = 8;           // random opening moves for variety
+    int minPly = 16;               // no samples before this ply
+    double sampleRate = 0.25;      // chance of keeping each quiet position
+    int maxPlies = 400;
+    uint64_t seed = 1;
+
+    std::string outputPrefix = "data";  // shards are <prefix>_<thread>.bin
+};
+
+// Plays self-play games on a pool of threads and writes quiet positions
+// labelled with the search score and final game result.
+class DataGenerator {
+public:
+    explicit DataGenerator(const DataGenConfig& config);
+
+    uint64_t run();
+
+    // False if a shard could not be opened or written; every worker
+    // stops at the first such failure
+    bool ok() const { return !failed; }
+
+private:
+    void worker(int index);
+    void fail(const std::string& path);
+
+    DataGenConfig config;
+
+    std::atomic<uint64_t> written{0};
+    std::atomic<bool> failed{false};
+    std::mutex printMutex;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+// Asset files compiled into the binary by cmake/EmbedAssets.cmake when
+// CHESS_EMBED_ASSETS is on. Paths are relative to the source tree,
+// e.g. "fonts/font.ttf".
+struct EmbeddedAsset {
+    const char* path;
+    const unsigned char* data;
+    std::size_t size;
+};
+
+extern const EmbeddedAsset embeddedAssets[];
+extern const std::size_t embeddedAssetCount;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "GameState.h"
+#include "Scene.h"
+
+class GameScene;
+
+// Result box drawn over the finished game with "Play Again" and
+// "Home Screen" buttons. Left arrow takes the last move back instead.
+class EndGamePopup : public Scene {
+public:
+    EndGamePopup(SceneStack& stack, GameScene& game, GameResult result, sf::Vector2u windowSize);
+
+    void handleEvent(const sf::Event& event) override;
+    void draw(sf::RenderTarget& target) override;
+    bool isOverlay() const override { return true; }
+
+private:
+    GameScene& game;
+
+    sf::RectangleShape overlay;
+    sf::RectangleShape popup;
+    sf::Text msg;
+    sf::RectangleShape playAgainBtn;
+    sf::RectangleShape homeBtn;
+    sf::Text playText;
+    sf::Text homeText;
+};
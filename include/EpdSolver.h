@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "Search.h"
+
+// One test position. Moves are kept in SAN as the suite wrote them.
+struct EpdPosition {
+    std::string fen;
+    std::string id;
+    std::vector<std::string> bestMoves;    // bm: any of these solves it
+    std::vector<std::string> avoidMoves;   // am: none of these may be played
+};
+
+// Reads an EPD suite: four position fields, then opcodes separated by
+// ';'. Only bm, am and id are used; positions with neither bm nor am
+// are skipped.
+std::vector<EpdPosition> loadEpd(const std::string& path);
+
+// Legal move written in standard algebraic notation ("Nbd7", "exd5",
+// "O-O", "e8=Q+"). Promotions other than to a queen are not supported by
+// the move generator and never match.
+bool parseSan(const Board& board, const std::string& san, Move& move);
+
+struct EpdResult {
+    bool valid = false;      // position and all its moves parsed
+    bool solved = false;     // right move at the end, and since solveMs
+    double solveMs = 0.0;    // when the right move became best and stayed
+    uint64_t solveNodes = 0;
+    int solveDepth = 0;
+
+    Move finalMove{};
+    int finalDepth = 0;
+};
+
+struct EpdConfig {
+    int timeMs = 1000;       // per position
+    int threads = 0;         // 0 = one per hardware thread
+    bool smp = false;        // all threads on one position, sharing a table
+    int hashMb = 64;         // per position
+};
+
+// Runs every position of a suite to the time limit and records, from the
+// iteration results, when the expected move first became best and never
+// changed again. One search gives the solve rate at every shorter limit.
+//
+// By default each thread takes whole positions. With smp the threads
+// search one position together, lazy-SMP style as in Analyzer, and node
+// counts are the main thread's.
+class EpdSolver {
+public:
+    explicit EpdSolver(const EpdConfig& config);
+
+    std::vector<EpdResult> solve(const std::vector<EpdPosition>& positions);
+
+    // Solved count at each time limit, plus a line per failed position
+    static void printSummary(std::ostream& out, const std::string& suite,
+                             const std::vector<EpdPosition>& positions,
+                             const std::vector<EpdResult>& results,
+                             const std::vector<int>& limitsMs);
+
+private:
+    EpdResult solveOne(const EpdPosition& position, int threads);
+    void report(const EpdPosition& position, const EpdResult& result);
+
+    EpdConfig config;
+
+    std::atomic<size_t> nextPosition{0};
+    std::atomic<size_t> finished{0};
+    size_t total = 0;
+    std::mutex printMutex;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Board.h"
+#include "PawnTable.h"
+#include "Piece.h"
+
+// Material value of a piece type in centipawns (king counts as 0).
+int pieceValue(PieceType type);
+
+// Static evaluation in centipawns from the side to move's point of view.
+// Pawn-structure terms come from the pawn table; the overload without
+// one uses a table private to the calling thread.
+int evaluate(const Board& board, PawnTable& pawns);
+int evaluate(const Board& board);
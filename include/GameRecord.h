@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "Move.h"
+
+// Move history of one game: two bytes per move plus a full Board snapshot
+// every `interval` plies. Any ply is reached from the nearest snapshot at
+// or before it, so seeking costs at most interval-1 moves however long the
+// game is.
+class GameRecord {
+public:
+    explicit GameRecord(const Board& start = Board(), int interval = 16);
+
+    void reset(const Board& start);
+
+    // Forget every move after `ply` (a new move from the middle of the game)
+    void truncate(int ply);
+
+    // Record `m`, played at the current end; `after` is the position it led to
+    void append(const Move& m, const Board& after);
+
+    int length() const { return static_cast<int>(moves.size()); }
+    const Board& startPosition() const { return snapshots.front(); }
+
+    // Position after the first `ply` moves
+    Board positionAt(int ply) const;
+
+    // Coordinate notation of the move that led to ply + 1, e.g. "e2e4"
+    std::string moveText(int ply) const;
+
+private:
+    struct CompactMove {
+        uint8_t from;
+        uint8_t to;
+    };
+
+    int interval;
+    std::vector<CompactMove> moves;
+    std::vector<Board> snapshots;   // snapshots[i] is the position at ply i * interval
+};
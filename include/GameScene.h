@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Analysis.h"
+#include "AnalysisView.h"
+#include "BoardRenderer.h"
+#include "GameState.h"
+#include "MoveListPanel.h"
+#include "Scene.h"
+#include "Search.h"
+
+// The board screen, with the move list to its right. Against a friend
+// both sides move by mouse; against the computer the engine plays Black
+// and searches on a worker thread so the window stays responsive.
+// Earlier positions can be reviewed from the move list; the engine only
+// plays once the game is back at its last position.
+//
+// In a game between friends, A toggles live analysis: background threads
+// search whatever position is on the board and the scene polls them for
+// the eval bar, best-move arrows and lines. The analysis table is kept
+// in analysis.tt in the working directory for the next session.
+class GameScene : public Scene {
+public:
+    enum class Opponent {
+        FRIEND,
+        COMPUTER
+    };
+
+    GameScene(SceneStack& stack, sf::Vector2u windowSize, Opponent opponent);
+    ~GameScene() override;
+
+    void handleEvent(const sf::Event& event) override;
+    bool update() override;
+    void draw(sf::RenderTarget& target) override;
+    bool isAnimating() const override { return thinking.valid(); }
+    int wakeIntervalMs() const override { return analyzer ? 100 : 0; }
+
+    // Used by the end-of-game popup
+    void restart();
+    void undoMove();
+    void redoMove();
+
+private:
+    void handleClick(sf::Vector2i position);
+    void seek(int ply);
+    void afterMove();
+    void toggleAnalysis();
+    bool pollAnalysis();
+    void clearSelection();
+    bool engineToMove() const;
+    int pixelToSquare(sf::Vector2i pos) const;
+
+    sf::Vector2u windowSize;
+    float tileSize;
+    Opponent opponent;
+    Color engineColor = Color::BLACK;
+
+    GameState game;
+    BoardRenderer renderer;
+    MoveListPanel panel;
+    bool changed = false;   // state changed by input the scheduler doesn't redraw for
+
+    int selectedSquare = -1;
+    std::vector<Move> selectedMoves;
+
+    SearchConfig engineConfig;
+    std::atomic<bool> stopThinking{false};  // set when leaving; the worker polls it
+    std::future<SearchResult> thinking;     // declared after the flag it reads
+
+    AnalysisView analysisView;
+    std::unique_ptr<Analyzer> analyzer;     // null while analysis is off
+    AnalysisInfo analysis;
+    uint64_t analysedKey = 0;
+    std::chrono::steady_clock::time_point lastPoll;
+};
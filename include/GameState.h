@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include "Board.h"
+#include "GameRecord.h"
+#include "Move.h"
+
+enum class GameResult {
+    ONGOING,
+    WHITE_WINS,
+    BLACK_WINS,
+    STALEMATE,
+    DRAW_REPETITION,
+    DRAW_FIFTY_MOVE
+};
+
+// Owns the game's Board and remembers what everyone asks about the
+// current position: the legal move list, whether the side to move is in
+// check, and whether the game is over. All of it is computed once when
+// the position changes (move, undo, redo or reset) and then shared by
+// GUI highlighting, end-of-game detection and adjudicators.
+//
+// The moves played go into a GameRecord. Undo, redo and seek move the
+// current ply within it; a new move from an earlier ply drops the rest.
+class GameState {
+public:
+    GameState();
+    explicit GameState(const Board& board);
+
+    const Board& getBoard() const { return board; }
+    Color getSideToMove() const { return board.getSideToMove(); }
+
+    const std::vector<Move>& legalMoves() const { return moves; }
+    std::vector<Move> legalMovesFrom(int square) const;
+    bool inCheck() const { return check; }
+    GameResult result() const { return gameResult; }
+    bool isOver() const { return gameResult != GameResult::ONGOING; }
+
+    void makeMove(const Move& m);
+    void undoLastMove();
+    void redoLastMove();
+    void seek(int ply);
+    void reset(const Board& start = Board());
+
+    bool canUndo() const { return ply > 0; }
+    bool canRedo() const { return ply < record.length(); }
+
+    const GameRecord& getRecord() const { return record; }
+    int getPly() const { return ply; }
+
+private:
+    void refresh();
+
+    Board board;
+    GameRecord record;
+    int ply = 0;
+
+    std::vector<Move> moves;
+    bool check = false;
+    GameResult gameResult = GameResult::ONGOING;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+// Where the pages of a LargeBuffer came from, best first
+enum class PageSource {
+    HUGETLB,       // reserved 2 MB pages (Linux MAP_HUGETLB)
+    LARGE_PAGES,   // Windows large pages (the account needs SeLockMemoryPrivilege)
+    TRANSPARENT,   // ordinary mapping marked MADV_HUGEPAGE; the kernel decides
+    NORMAL
+};
+
+// Page-aligned memory for big, randomly probed tables. Huge pages cut the
+// TLB misses that dominate probing a table of several GB; each source is
+// tried in turn and a failure only falls through to the next. The memory
+// starts zeroed but untouched, so the owner decides which threads touch
+// it first (see parallelChunks).
+class LargeBuffer {
+public:
+    LargeBuffer() = default;
+    explicit LargeBuffer(size_t bytes);
+    ~LargeBuffer();
+
+    LargeBuffer(LargeBuffer&& other) noexcept;
+    LargeBuffer& operator=(LargeBuffer&& other) noexcept;
+    LargeBuffer(const LargeBuffer&) = delete;
+    LargeBuffer& operator=(const LargeBuffer&) = delete;
+
+    void* data() const { return aligned; }
+    size_t size() const { return bytes; }
+    PageSource source() const { return pageSource; }
+
+    // Bytes currently backed by huge pages. For transparent huge pages
+    // this asks the kernel, so call it after the memory has been touched.
+    size_t hugeBytes() const;
+
+    // e.g. "1024 MB, transparent huge pages (1022 MB in 2 MB pages)"
+    std::string describe() const;
+
+private:
+    void release();
+
+    void* base = nullptr;      // what the allocator returned
+    size_t mapped = 0;         // and its length
+    void* aligned = nullptr;
+    size_t bytes = 0;
+    PageSource pageSource = PageSource::NORMAL;
+};
+
+// Runs body(begin, end) over [0, count) split across threads, at least
+// minChunk items each, so small jobs stay on the calling thread. Used to
+// touch big tables first from many threads: on Linux a page is placed on
+// the NUMA node of the thread that first writes it, which spreads the
+// table over the nodes, and the clearing runs in parallel too.
+void parallelChunks(size_t count, size_t minChunk,
+                    const std::function<void(size_t begin, size_t end)>& body);
+
+// Largest power of two not above n (1 for n == 0). Hash tables are sized
+// with it so a key is indexed with a mask.
+inline size_t floorPowerOfTwo(size_t n) {
+    size_t count = 1;
+    while (count * 2 <= n)
+        count *= 2;
+    return count;
+}
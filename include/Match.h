@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "GameState.h"
+#include "Search.h"
+
+enum class GameOutcome {
+    WHITE_WIN,
+    BLACK_WIN,
+    DRAW
+};
+
+// Decides when a game is over: the GameState result covers mate,
+// stalemate, threefold repetition and the fifty-move rule; the ply cap
+// is tracked here.
+class GameAdjudicator {
+public:
+    explicit GameAdjudicator(int maxPlies = 400);
+
+    // Call once per position, before the side to move plays.
+    bool isOver(const GameState& game, GameOutcome& outcome);
+
+    // Call for every move made.
+    void recordMove();
+
+private:
+    int maxPlies;
+    int plies = 0;
+};
+
+// Sequential probability ratio test between H0: elo == elo0 and
+// H1: elo == elo1, with error rates alpha / beta.
+struct SprtConfig {
+    bool enabled = true;
+    double elo0 = 0.0;
+    double elo1 = 5.0;
+    double alpha = 0.05;
+    double beta = 0.05;
+};
+
+struct MatchConfig {
+    SearchConfig engines[2];
+    std::string names[2] = {"engineA", "engineB"};
+
+    int games = 1000;       // rounded up to a whole number of pairs
+    int threads = 0;        // 0 = one worker per hardware thread
+    int maxPlies = 400;     // longer games are adjudicated as draws
+
+    std::vector<std::string> openings;  // FENs, each played once per colour
+    SprtConfig sprt;
+};
+
+// Results from the first engine's point of view.
+struct MatchStats {
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+
+    int played() const { return wins + draws + losses; }
+    double score() const;
+};
+
+// Reads FEN/EPD positions, one per line. EPD opcodes after the four
+// position fields are ignored. Lines that are not a valid position are
+// reported and skipped.
+std::vector<std::string> loadOpenings(const std::string& path);
+
+double eloFromScore(double score);
+double sprtLogLikelihoodRatio(const MatchStats& stats, double elo0, double elo1);
+
+// Plays games between two engine configurations on a pool of worker
+// threads, one game per worker at a time. Each opening is played twice
+// with colours swapped, and every game starts with fresh tables, so a
+// result never depends on which games a thread happened to play before.
+class MatchRunner {
+public:
+    explicit MatchRunner(const MatchConfig& config);
+
+    MatchStats run();
+
+private:
+    void worker();
+    GameOutcome playGame(const Board& start, Search& white, Search& black);
+    void recordResult(int gameIndex, GameOutcome outcome);
+
+    MatchConfig config;
+    std::vector<Board> openings;   // config.openings that parsed
+    int totalGames = 0;
+
+    std::atomic<int> nextGame{0};
+    std::atomic<bool> stopRequested{false};
+
+    std::mutex statsMutex;
+    MatchStats stats;
+};
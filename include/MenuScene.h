@@ -0,0 +1,22 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "Scene.h"
+
+// Title screen: start a game against a friend or against the engine.
+class MenuScene : public Scene {
+public:
+    MenuScene(SceneStack& stack, sf::Vector2u windowSize);
+
+    void handleEvent(const sf::Event& event) override;
+    void draw(sf::RenderTarget& target) override;
+
+private:
+    sf::Vector2u windowSize;
+
+    sf::Text title;
+    sf::RectangleShape friendBtn;
+    sf::RectangleShape computerBtn;
+    sf::Text friendText;
+    sf::Text computerText;
+};
@@ -5,7 +5,7 @@
 struct Move {
     int from;
     int to;
-    Piece captured;
+    Piece captured = {Color::WHITE, PieceType::NONE};   // left as is by castling
 
     bool promotion = false;
     bool castling = false;
@@ -21,4 +21,12 @@ struct Move {
     int prevLastMoveFrom;
     int prevLastMoveTo;
     Piece prevLastMovePiece;
+
+    int prevHalfmoveClock;
 };
+
+// Neither a capture nor a promotion; castling is quiet. The search's
+// killers, reductions and futility pruning only apply to quiet moves.
+inline bool isQuiet(const Move& m) {
+    return m.captured.type == PieceType::NONE && !m.promotion;
+}
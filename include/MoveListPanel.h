@@ -0,0 +1,28 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "GameRecord.h"
+
+// Side panel next to the board: the game's moves two to a row with the
+// current one highlighted, and a slider along the bottom covering the
+// whole game. Clicking a move or dragging the slider asks for a seek.
+class MoveListPanel {
+public:
+    explicit MoveListPanel(sf::FloatRect area);
+
+    // Ply to seek to, or -1 if the event didn't ask for one
+    int handleEvent(const sf::Event& event, const GameRecord& record, int currentPly);
+
+    void draw(sf::RenderTarget& target, const GameRecord& record, int currentPly) const;
+
+private:
+    int visibleRows() const;
+    int firstVisibleRow(const GameRecord& record, int currentPly) const;
+    int plyAtSlider(float x, const GameRecord& record) const;
+
+    sf::FloatRect area;
+    sf::FloatRect listArea;
+    sf::FloatRect sliderArea;
+
+    bool dragging = false;
+};
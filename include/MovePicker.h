@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include "Board.h"
+#include "Move.h"
+#include "SearchContext.h"
+
+// MVV-LVA: most valuable victim first, cheapest attacker breaks ties.
+// Captures score above promotions, which score above quiet moves.
+int mvvLva(const Board& board, const Move& m);
+
+// Hands out pseudo-legal moves for the side to move in stages, so a
+// cutoff early on skips generating the rest:
+//   1. the hash move, validated with Board::lookupMove
+//   2. captures and promotions, best MVV-LVA first
+//   3. the ply's killer moves, validated like the hash move
+//   4. the other quiet moves
+// Stages 3 and 4 are skipped by a captures-only picker. The caller still
+// has to reject moves that leave its king in check.
+//
+// Moves are generated into the frame's reserved list and capture scores
+// come from the arena, released when the picker goes out of scope.
+class MovePicker {
+public:
+    MovePicker(const Board& board, const Move* hashMove, SearchFrame& frame,
+               Arena& arena, bool capturesOnly = false);
+
+    bool next(Move& move);
+
+private:
+    enum class Stage {
+        HASH_MOVE,
+        GENERATE_CAPTURES,
+        CAPTURES,
+        KILLERS,
+        GENERATE_QUIETS,
+        QUIETS,
+        DONE
+    };
+
+    bool isHashMove(const Move& m) const;
+
+    const Board& board;
+    bool capturesOnly;
+    Stage stage = Stage::HASH_MOVE;
+
+    Move hashMove{};
+    bool hasHashMove = false;
+
+    const SearchFrame& frame;
+    std::vector<Move>& moves;
+    ArenaScope scratch;
+    Arena& arena;
+    int* scores = nullptr;
+    size_t index = 0;
+};
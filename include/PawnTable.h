@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Cached evaluation of one pawn structure. Scores are from White's
+// point of view; bitboards are indexed by Color.
+struct PawnEntry {
+    uint64_t key = 0;
+    int16_t score = 0;
+    uint64_t pawns[2] = {0, 0};
+    uint64_t passed[2] = {0, 0};
+};
+
+// Small direct-mapped cache keyed by Board::pawnKey(). Pawn structures
+// repeat far more often than positions, so even a few thousand entries
+// hit almost every time. Not thread-safe: each search thread owns one.
+//
+// A fresh table holds key 0 everywhere, which is the key of a board
+// without pawns, and the empty entry is the right answer for it.
+class PawnTable {
+public:
+    explicit PawnTable(size_t entries = 16384);
+
+    // Entry for key; filled by the caller when its key doesn't match
+    PawnEntry& slot(uint64_t key) { return entries[key & mask]; }
+
+    void clear();
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+private:
+    std::vector<PawnEntry> entries;
+    size_t mask = 0;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+struct PerftShardConfig {
+    std::string fen;            // empty = initial position
+    int depth = 8;
+    int splitPly = 2;           // subtrees start this many plies below the root
+
+    // One shell command per concurrent worker, each a chess_perft that
+    // takes --depth and --fen: a local binary or e.g. "ssh box chess_perft"
+    std::vector<std::string> workers;
+
+    std::string journal;        // completed subtrees, for resuming; empty = none
+};
+
+// Perft split into subtree jobs that run in separate processes. Every
+// move sequence of splitPly plies from the root is one job; worker
+// processes are started through a pipe per job, so a worker command can
+// just as well run on another machine. Finished jobs are appended to the
+// journal as they come in, and a rerun with the same journal only runs
+// what is missing. Counts are merged per root move.
+class ShardedPerft {
+public:
+    explicit ShardedPerft(const PerftShardConfig& config);
+
+    // False if the setup is invalid or some job could not be completed;
+    // the journal keeps whatever did finish.
+    bool run();
+
+    uint64_t total() const;
+
+    // Same format as Board::perftDivide
+    void printDivide(std::ostream& out) const;
+
+private:
+    struct Job {
+        std::string path;       // moves from the root, space separated
+        std::string fen;
+        uint64_t nodes = 0;
+        bool done = false;
+    };
+
+    void enumerate(Board& board, int ply, const std::string& path);
+    bool readJournal();
+    void worker(const std::string& command);
+    bool runJob(const std::string& command, const Job& job, uint64_t& nodes) const;
+    void record(Job& job, uint64_t nodes);
+
+    PerftShardConfig config;
+    std::vector<Job> jobs;
+    std::vector<std::string> rootMoves;   // in generation order, for printing
+
+    std::atomic<size_t> nextJob{0};
+    std::atomic<size_t> finished{0};
+    std::mutex mutex;                     // journal and console
+    std::ofstream* journalOut = nullptr;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+#ifdef CHESS_PROFILE
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+// Call counts and cycle totals for the Board hot paths. Only built in
+// with the CHESS_PROFILE option; otherwise CHESS_PROFILE_SCOPE expands to
+// nothing and Board carries no instrumentation at all.
+//
+// Each thread counts into its own slots, so searches and datagen workers
+// never contend. Cycle totals are inclusive: legality filtering includes
+// the applyMove/undoMove calls it makes.
+enum class ProfilePoint {
+    PSEUDO_LEGAL_MOVES,
+    ADD_PAWN_MOVES,
+    ADD_KNIGHT_MOVES,
+    ADD_BISHOP_MOVES,
+    ADD_ROOK_MOVES,
+    ADD_QUEEN_MOVES,
+    ADD_KING_MOVES,
+    SQUARE_ATTACKED,
+    KING_IN_CHECK,
+    APPLY_MOVE,
+    UNDO_MOVE,
+    LEGAL_FILTER,
+    COUNT_LEGAL_MOVES,
+    COUNT
+};
+
+namespace profile {
+
+struct Counter {
+    uint64_t calls = 0;
+    uint64_t cycles = 0;
+};
+
+using Counters = std::array<Counter, static_cast<size_t>(ProfilePoint::COUNT)>;
+
+constexpr bool enabled() {
+#ifdef CHESS_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* name(ProfilePoint point);
+
+// Sum over every thread that has counted anything so far.
+Counters totals();
+
+// Zero all threads' counters. Call between runs, not while workers count.
+void reset();
+
+void printReport(std::ostream& out);
+void writeJson(std::ostream& out);
+
+#ifdef CHESS_PROFILE
+
+Counters* registerThread();
+
+extern thread_local Counters* localCounters;
+
+inline Counters& threadCounters() {
+    if (!localCounters)
+        localCounters = registerThread();
+    return *localCounters;
+}
+
+inline uint64_t readCycles() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+class Scope {
+public:
+    explicit Scope(ProfilePoint point)
+        : counter(threadCounters()[static_cast<size_t>(point)]),
+          start(readCycles()) {}
+
+    ~Scope() {
+        ++counter.calls;
+        counter.cycles += readCycles() - start;
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    Counter& counter;
+    uint64_t start;
+};
+
+#endif
+
+} // namespace profile
+
+#ifdef CHESS_PROFILE
+#define CHESS_PROFILE_SCOPE(point) profile::Scope chessProfileScope(ProfilePoint::point)
+#else
+#define CHESS_PROFILE_SCOPE(point) ((void)0)
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <optional>
+#include <SFML/Graphics.hpp>
+
+// Decides when a window has to be redrawn. Input events and explicit
+// markDirty() calls (position changes) schedule one redraw; while
+// animating, every frame is drawn. When there is nothing to draw,
+// nextEvent() blocks in waitEvent so an idle window uses no CPU, and the
+// framerate cap bounds the cost while it is active. A wake interval
+// bounds that wait, for screens that show results of background work.
+class RenderScheduler {
+public:
+    explicit RenderScheduler(sf::RenderWindow& window, unsigned maxFramerate = 60);
+
+    // Use as: while (auto event = scheduler.nextEvent()) { ... }
+    // Blocks for the first event of a frame only if no redraw is pending.
+    std::optional<sf::Event> nextEvent();
+
+    void markDirty() { dirty = true; }
+    void setAnimating(bool on) { animating = on; }
+    void setWakeInterval(int ms) { wakeIntervalMs = ms; }   // 0 = wait for input
+
+    // True if this frame should be drawn; clears the dirty flag.
+    bool beginFrame();
+
+private:
+    sf::RenderWindow& window;
+
+    bool dirty = true;       // first frame is always drawn
+    bool animating = false;
+    bool draining = false;   // inside the event loop of the current frame
+    int wakeIntervalMs = 0;
+};
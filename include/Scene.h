@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+class SceneStack;
+
+// One screen of the GUI (menu, game, popup). All scenes share the single
+// application window; only the top scene receives input.
+class Scene {
+public:
+    virtual ~Scene() = default;
+
+    virtual void handleEvent(const sf::Event& event) = 0;
+
+    // Called once per frame; returns true if the screen needs redrawing.
+    virtual bool update() { return false; }
+
+    virtual void draw(sf::RenderTarget& target) = 0;
+
+    // Overlays are drawn on top of the scene below them.
+    virtual bool isOverlay() const { return false; }
+
+    // True while the scene needs frames without input (e.g. engine thinking).
+    virtual bool isAnimating() const { return false; }
+
+    // How often an idle window should still wake to call update(), for
+    // scenes that watch background work; 0 means only on input.
+    virtual int wakeIntervalMs() const { return 0; }
+
+protected:
+    explicit Scene(SceneStack& stack) : stack(stack) {}
+
+    SceneStack& stack;
+};
+
+// Owns the scenes. push/pop requested while a scene is handling an event
+// take effect in applyPending(), so a scene never destroys itself mid-call.
+class SceneStack {
+public:
+    void push(std::unique_ptr<Scene> scene);
+    void pop();
+    void clear();
+
+    void applyPending();
+
+    bool empty() const { return scenes.empty(); }
+
+    void handleEvent(const sf::Event& event);
+    bool update();
+    void draw(sf::RenderTarget& target);
+    bool isAnimating() const;
+    int wakeIntervalMs() const;   // shortest interval any scene asks for
+
+private:
+    struct Change {
+        enum class Kind { PUSH, POP, CLEAR } kind;
+        std::unique_ptr<Scene> scene;
+    };
+
+    std::vector<std::unique_ptr<Scene>> scenes;
+    std::vector<Change> pending;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "Move.h"
+#include "PawnTable.h"
+#include "SearchContext.h"
+#include "SearchStats.h"
+#include "TranspositionTable.h"
+
+constexpr int MATE_SCORE = 30000;
+constexpr int INFINITE_SCORE = 32000;
+
+// One engine configuration. Limits of 0 mean "unlimited"; the search
+// always stops at maxDepth. The selectivity switches are there for A/B
+// matches; with all of them off the search is plain alpha-beta.
+struct SearchConfig {
+    int maxDepth = 4;
+    uint64_t maxNodes = 0;
+    int moveTimeMs = 0;
+    bool quiescence = true;
+    int hashMb = 16;
+    int multiPv = 1;    // root lines searched with exact scores
+
+    bool aspiration = true;     // root window around the last score
+    int aspirationWindow = 50;  // half width in centipawns, doubled per fail
+    bool pvs = true;            // zero-window search after the first move
+    bool nullMove = true;
+    bool lmr = true;            // reduce late quiet moves
+    bool futility = true;       // skip quiet moves that cannot reach alpha
+};
+
+// Turns off one selectivity feature by name ("aspiration", "pvs",
+// "nullmove", "lmr", "futility"); false for an unknown name
+bool disableSearchFeature(SearchConfig& config, const std::string& name);
+
+// One root line, side to move's point of view. Where the PV collected
+// during the search stops early (a table cutoff), it is continued from
+// the transposition table and may still be cut short.
+struct SearchLine {
+    int score = 0;
+    std::vector<Move> pv;
+};
+
+struct SearchResult {
+    Move bestMove{};
+    bool hasMove = false;
+    int score = 0;      // side to move's point of view
+    int depth = 0;      // last fully completed iteration
+    uint64_t nodes = 0;
+    std::vector<SearchLine> lines;   // best first, up to multiPv
+    SearchStats stats;
+};
+
+// Iterative-deepening principal variation search inside aspiration
+// windows, with null-move pruning, late move reductions and futility
+// pruning. Interior nodes take moves from a MovePicker, hash move first,
+// then captures and killers. A Search has no global state, so one
+// instance per thread can run concurrently; its SearchContext is
+// allocated with it and reused by every think(). Without a table passed
+// in it makes its own of config.hashMb; searches given the same table
+// share what they find. The table is kept between think() calls.
+class Search {
+public:
+    explicit Search(const SearchConfig& config = SearchConfig(),
+                    std::shared_ptr<TranspositionTable> table = nullptr);
+
+    SearchResult think(const Board& board);
+
+    // Forget everything learnt so far: the transposition table (also for
+    // any other search sharing it), the pawn table and the killers. Games
+    // that must not influence each other, as in a match, start with this.
+    void newGame();
+
+    // Stop as soon as *flag becomes true (checked at every node)
+    void setStopFlag(const std::atomic<bool>* flag) { stopFlag = flag; }
+
+    // Called with the result so far after each completed iteration
+    void setIterationCallback(std::function<void(const SearchResult&)> callback) {
+        onIteration = std::move(callback);
+    }
+
+    const SearchConfig& getConfig() const { return config; }
+
+private:
+    void searchRoot(Board& board, const std::vector<Move>& rootMoves, int depth,
+                    int alpha, int beta, size_t lineCount, std::vector<SearchLine>& top);
+    int negamax(Board& board, int depth, int alpha, int beta, int ply, bool allowNull = true);
+    int quiescence(Board& board, int alpha, int beta, int ply);
+    void orderMoves(const Board& board, std::vector<Move>& moves) const;
+    void extendPv(Board board, std::vector<Move>& pv, int maxLength) const;
+    bool shouldStop();
+    double elapsedMs() const;
+
+    SearchConfig config;
+    std::shared_ptr<TranspositionTable> tt;
+    PawnTable pawnTable;   // per search, never shared between threads
+    SearchContext context;
+
+    const std::atomic<bool>* stopFlag = nullptr;
+    std::function<void(const SearchResult&)> onIteration;
+
+    SearchCounters counters;
+    bool stopped = false;
+    std::chrono::steady_clock::time_point startTime;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Move.h"
+
+constexpr int MAX_PLY = 64;
+constexpr int MAX_MOVES = 256;   // more than any legal position has
+
+// Bump allocator over one block reserved up front. Allocations are
+// released in stack order by rewinding to a mark, which is how search
+// scratch data lives and dies anyway. Running out is a sizing bug, not a
+// position-dependent condition, and throws std::bad_alloc.
+class Arena {
+public:
+    explicit Arena(size_t bytes);
+
+    template <typename T>
+    T* allocate(size_t count) {
+        return static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+    }
+
+    size_t mark() const { return used; }
+    void release(size_t mark) { used = mark; }
+
+    size_t highWater() const { return peak; }
+
+private:
+    void* allocateBytes(size_t bytes, size_t align);
+
+    std::unique_ptr<unsigned char[]> buffer;
+    size_t capacity = 0;
+    size_t used = 0;
+    size_t peak = 0;
+};
+
+// Rewinds an arena when it goes out of scope
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena) : arena(arena), saved(arena.mark()) {}
+    ~ArenaScope() { arena.release(saved); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena& arena;
+    size_t saved;
+};
+
+// Search state for one ply. The move made from this ply is kept whole:
+// applyMove stores its undo information in the Move itself.
+struct SearchFrame {
+    std::vector<Move> moves;      // picker buffer, capacity MAX_MOVES
+    Move move{};                  // move being searched from this ply
+
+    std::array<Move, MAX_PLY + 1> pv;   // principal variation from this ply
+    int pvLength = 0;
+
+    std::array<Move, 2> killers{};   // quiet moves that caused a cutoff
+    int killerCount = 0;
+
+    int staticEval = 0;
+
+    bool isKiller(const Move& m) const {
+        for (int i = 0; i < killerCount; ++i) {
+            if (m.from == killers[i].from && m.to == killers[i].to)
+                return true;
+        }
+        return false;
+    }
+};
+
+// Everything one search thread needs per node, allocated once. Inside
+// negamax and quiescence nothing else touches the heap: move lists are
+// reserved to MAX_MOVES and scratch arrays come from the arena.
+class SearchContext {
+public:
+    SearchContext();
+
+    // Fresh killers and PVs for a new search
+    void reset();
+
+    SearchFrame& frame(int ply) { return frames[ply]; }
+
+    // PV at ply = move followed by the PV found one ply deeper
+    void updatePv(int ply, const Move& move);
+
+    // Remember a quiet move that refuted the position at ply
+    void addKiller(int ply, const Move& move);
+
+    Arena arena;
+
+private:
+    // One more than MAX_PLY: the child PV of the deepest node is read
+    std::vector<SearchFrame> frames;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Counters one search keeps while it runs. They are plain increments on
+// the search's own thread, cheap enough to stay on in every build.
+struct SearchCounters {
+    uint64_t nodes = 0;             // main search and quiescence
+    uint64_t qnodes = 0;            // quiescence only
+    int selDepth = 0;               // deepest ply reached so far
+
+    uint64_t betaCutoffs = 0;
+    uint64_t firstMoveCutoffs = 0;  // cutoffs by the first legal move
+
+    uint64_t ttProbes = 0;
+    uint64_t ttHits = 0;
+    uint64_t ttCollisions = 0;      // slot held another position
+    uint64_t ttCutoffs = 0;         // hits that ended the node
+
+    uint64_t nullMoveTries = 0;
+    uint64_t nullMoveCutoffs = 0;
+    uint64_t futilityPrunes = 0;        // quiet moves skipped near the leaves
+    uint64_t lmrReductions = 0;
+    uint64_t lmrResearches = 0;         // reduced moves that beat alpha
+    uint64_t pvsResearches = 0;         // zero-window moves searched again
+    uint64_t aspirationResearches = 0;  // root windows widened
+
+    // Work done since an earlier snapshot; selDepth is kept as is
+    SearchCounters since(const SearchCounters& earlier) const;
+};
+
+struct IterationStats {
+    int depth = 0;
+    int score = 0;              // side to move's point of view
+    double timeMs = 0.0;        // since the search started
+    double iterationMs = 0.0;   // this iteration alone
+    double branchingFactor = 0.0;   // nodes over the previous iteration's
+    SearchCounters counters;    // this iteration alone
+};
+
+// Per-iteration and whole-search statistics of one think()
+struct SearchStats {
+    std::vector<IterationStats> iterations;   // completed ones only
+    SearchCounters total;                     // including an unfinished last iteration
+    double timeMs = 0.0;
+
+    // Nodes ^ (1 / depth) over the completed iterations
+    double effectiveBranchingFactor() const;
+};
+
+// Percentage helper that is 0 for an empty denominator
+double percent(uint64_t part, uint64_t whole);
+
+// UCI score field: "cp 35" or "mate 3" / "mate -2"
+std::string uciScore(int score);
+
+// "info string ..." line with the counters of the latest iteration
+std::string uciStatsInfo(const SearchStats& stats);
+
+// Whole search as a JSON object
+void writeStatsJson(std::ostream& out, const SearchStats& stats);
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "LargeBuffer.h"
+#include "Move.h"
+
+enum class Bound : uint8_t {
+    NONE,
+    EXACT,
+    LOWER,   // score >= stored (beta cutoff)
+    UPPER    // score <= stored (failed low)
+};
+
+// Decoded table entry. from == to means no best move.
+struct TTEntry {
+    uint64_t key = 0;
+    int16_t score = 0;
+    int8_t depth = 0;
+    Bound bound = Bound::NONE;
+    uint8_t from = 0;
+    uint8_t to = 0;
+
+    bool hasMove() const { return from != to; }
+};
+
+// Hash table of searched positions keyed by Board::hashKey(), one entry
+// per slot, always-replace except that a shallower result for the same
+// position keeps the deeper one.
+//
+// Several searches may share one table. A slot is two relaxed atomic
+// words, the key stored XORed with the data, so an entry torn by a
+// concurrent write fails the key check instead of being misread.
+//
+// A table can be saved to a snapshot file and restored later, so a new
+// analysis session starts from what earlier ones found. Snapshots hold
+// only the occupied slots, are independent of the table size, and are
+// read through a memory mapping. Errors go to std::cerr and return false.
+//
+// The slots live in a LargeBuffer, on huge pages where the system gives
+// them, and big tables are constructed and cleared by several threads.
+class TranspositionTable {
+public:
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    void resize(size_t megabytes);
+    void clear();
+
+    bool probe(uint64_t key, TTEntry& entry) const;
+    bool probe(uint64_t key, TTEntry& entry, bool& collision) const;   // collision: slot held another key
+    void store(uint64_t key, int depth, int score, Bound bound, const Move* bestMove);
+
+    size_t size() const { return count; }
+    int hashfull() const;   // occupied slots per mille, from a sample
+    std::string memoryReport() const { return memory.describe(); }
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);    // clear, then merge
+    bool merge(const std::string& path);   // deeper entry wins a slot
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check{0};   // key ^ data
+        std::atomic<uint64_t> data{0};
+    };
+
+    void mergeEntry(uint64_t key, uint64_t data);
+
+    static uint64_t pack(const TTEntry& entry);
+    static TTEntry unpack(uint64_t key, uint64_t data);
+
+    LargeBuffer memory;
+    Slot* slots = nullptr;
+    size_t count = 0;
+    uint64_t mask = 0;
+};
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include "Analysis.h"
+
+namespace {
+
+// One thread for all snapshot loads and saves. A table of several GB
+// takes seconds to read or write; here that happens off the GUI thread,
+// and in order, so a session's save is finished before the next
+// analyzer loads the file. Saves still queued at exit are completed.
+class SnapshotQueue {
+public:
+    static SnapshotQueue& instance() {
+        static SnapshotQueue queue;
+        return queue;
+    }
+
+    std::shared_future<void> post(std::function<void()> task) {
+        std::packaged_task<void()> job(std::move(task));
+        std::shared_future<void> done = job.get_future().share();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(std::move(job));
+        }
+        wake.notify_one();
+        return done;
+    }
+
+    ~SnapshotQueue() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+private:
+    SnapshotQueue() : worker([this]() { run(); }) {}
+
+    void run() {
+        while (true) {
+            std::packaged_task<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this]() { return closing || !jobs.empty(); });
+                if (jobs.empty())
+                    return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::packaged_task<void()>> jobs;
+    bool closing = false;
+    std::thread worker;   // last, so it starts after the rest exists
+};
+
+} // namespace
+
+
+Analyzer::Analyzer(int threads, int multiPv, size_t hashMb, std::string snapshotPath)
+    : threads(std::max(1, threads)),
+      multiPv(std::max(1, multiPv)),
+      snapshotPath(std::move(snapshotPath)),
+      tt(std::make_shared<TranspositionTable>(hashMb)) {
+
+    if (this->snapshotPath.empty())
+        return;
+
+    // No snapshot yet is the normal first run, not an error
+    snapshotLoaded = SnapshotQueue::instance().post([table = tt, path = this->snapshotPath]() {
+        if (std::ifstream(path).good())
+            table->load(path);
+    });
+}
+
+
+Analyzer::~Analyzer() {
+    stop();
+
+    // The queued job keeps the table alive until it is written
+    if (!snapshotPath.empty()) {
+        SnapshotQueue::instance().post([table = tt, path = snapshotPath]() {
+            table->save(path);
+        });
+    }
+}
+
+
+void Analyzer::start(const Board& position) {
+    stop();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        latest = AnalysisInfo{};
+        latest.positionKey = position.hashKey();
+        ++version;
+    }
+
+    SearchConfig config;
+    config.maxDepth = MAX_PLY - 1;
+
+    for (int i = 0; i < threads; ++i) {
+        bool reporter = (i == 0);
+
+        workers.emplace_back([this, position, config, reporter]() {
+            SearchConfig threadConfig = config;
+            threadConfig.multiPv = reporter ? multiPv : 1;
+
+            // The table is not searched until the snapshot is in it
+            if (snapshotLoaded.valid()) {
+                while (snapshotLoaded.wait_for(std::chrono::milliseconds(10)) !=
+                       std::future_status::ready) {
+                    if (stopFlag)
+                        return;
+                }
+            }
+
+            Search search(threadConfig, tt);
+            search.setStopFlag(&stopFlag);
+            if (reporter) {
+                search.setIterationCallback([this, &position](const SearchResult& result) {
+                    publish(position, result);
+                });
+            }
+            search.think(position);
+        });
+    }
+}
+
+
+void Analyzer::stop() {
+    stopFlag = true;
+    for (auto& worker : workers)
+        worker.join();
+    workers.clear();
+    stopFlag = false;
+}
+
+
+bool Analyzer::poll(AnalysisInfo& info) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (version == polledVersion)
+        return false;
+
+    info = latest;
+    polledVersion = version;
+    return true;
+}
+
+
+void Analyzer::publish(const Board& position, const SearchResult& result) {
+    AnalysisInfo info;
+    info.positionKey = position.hashKey();
+    info.depth = result.depth;
+    info.nodes = result.nodes;
+    info.lines = result.lines;
+
+    if (position.getSideToMove() == Color::BLACK) {
+        for (auto& line : info.lines)
+            line.score = -line.score;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    latest = std::move(info);
+    ++version;
+}
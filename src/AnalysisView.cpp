@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include "AnalysisView.h"
+#include "Assets.h"
+
+namespace {
+
+bool isMateScore(int score) {
+    return std::abs(score) >= MATE_SCORE - MAX_PLY;
+}
+
+// "+0.35", "-1.20", "#3" (White mates in 3), "#-2"
+std::string formatScore(int score) {
+    char buffer[16];
+    if (isMateScore(score)) {
+        int moves = (MATE_SCORE - std::abs(score) + 1) / 2;
+        std::snprintf(buffer, sizeof(buffer), "#%s%d", score < 0 ? "-" : "", moves);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%+.2f", score / 100.0);
+    }
+    return buffer;
+}
+
+std::string squareName(int sq) {
+    return std::string{static_cast<char>('a' + sq % 8), static_cast<char>('1' + sq / 8)};
+}
+
+// Share of the bar that is White's, from the bottom
+float whiteShare(int score) {
+    if (isMateScore(score))
+        return score > 0 ? 1.f : 0.f;
+    float share = 0.5f + 0.5f * std::tanh(score / 600.f);
+    return std::max(0.03f, std::min(0.97f, share));
+}
+
+} // namespace
+
+
+AnalysisView::AnalysisView(float tileSize, sf::FloatRect barArea, sf::FloatRect linesArea,
+                           bool analysisAvailable)
+    : tileSize(tileSize), barArea(barArea), linesArea(linesArea),
+      analysisAvailable(analysisAvailable) {
+}
+
+
+void AnalysisView::draw(sf::RenderTarget& target, const AnalysisInfo* info) const {
+    if (info) {
+        // Weaker lines first so the best arrow ends up on top
+        for (size_t i = info->lines.size(); i-- > 0; ) {
+            if (info->lines[i].pv.empty())
+                continue;
+            sf::Color color = (i == 0) ? sf::Color(0, 140, 255, 200) : sf::Color(0, 140, 255, 90);
+            drawArrow(target, info->lines[i].pv.front(), color);
+        }
+    }
+
+    drawBar(target, info);
+    drawLines(target, info);
+}
+
+
+void AnalysisView::drawBar(sf::RenderTarget& target, const AnalysisInfo* info) const {
+    sf::RectangleShape black(barArea.size);
+    black.setPosition(barArea.position);
+    black.setFillColor(sf::Color(30, 30, 30));
+    target.draw(black);
+
+    if (!info || info->lines.empty())
+        return;
+
+    float height = barArea.size.y * whiteShare(info->lines.front().score);
+
+    sf::RectangleShape white({barArea.size.x, height});
+    white.setPosition({barArea.position.x, barArea.position.y + barArea.size.y - height});
+    white.setFillColor(sf::Color(235, 235, 235));
+    target.draw(white);
+}
+
+
+void AnalysisView::drawArrow(sf::RenderTarget& target, const Move& move, sf::Color color) const {
+    sf::Vector2f from = squareCenter(move.from);
+    sf::Vector2f to = squareCenter(move.to);
+
+    sf::Vector2f delta = to - from;
+    float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    if (length < 1.f)
+        return;
+
+    sf::Vector2f dir = delta / length;
+    sf::Vector2f normal(-dir.y, dir.x);
+
+    float shaftWidth = tileSize * 0.12f;
+    float headWidth = tileSize * 0.36f;
+    float headLength = tileSize * 0.35f;
+    sf::Vector2f headBase = to - dir * headLength;
+
+    // Two convex pieces: SFML can't fill the concave outline in one shape
+    sf::ConvexShape shaft(4);
+    shaft.setPoint(0, from + normal * (shaftWidth / 2));
+    shaft.setPoint(1, headBase + normal * (shaftWidth / 2));
+    shaft.setPoint(2, headBase - normal * (shaftWidth / 2));
+    shaft.setPoint(3, from - normal * (shaftWidth / 2));
+    shaft.setFillColor(color);
+    target.draw(shaft);
+
+    sf::ConvexShape head(3);
+    head.setPoint(0, headBase + normal * (headWidth / 2));
+    head.setPoint(1, to);
+    head.setPoint(2, headBase - normal * (headWidth / 2));
+    head.setFillColor(color);
+    target.draw(head);
+}
+
+
+void AnalysisView::drawLines(sf::RenderTarget& target, const AnalysisInfo* info) const {
+    const sf::Font& font = Assets::instance().font("fonts/font.ttf");
+
+    sf::RectangleShape background(linesArea.size);
+    background.setPosition(linesArea.position);
+    background.setFillColor(sf::Color(25, 25, 25));
+    target.draw(background);
+
+    float x = linesArea.position.x + 10.f;
+    float y = linesArea.position.y + 8.f;
+
+    std::string header;
+    if (!info && !analysisAvailable)
+        return;
+    if (!info)
+        header = "Press A to analyse";
+    else if (info->depth == 0)
+        header = "Analysing...";
+    else
+        header = "Depth " + std::to_string(info->depth) + "  " +
+                 std::to_string(info->nodes / 1000) + "k nodes";
+
+    sf::Text title(font, header, 18);
+    title.setFillColor(sf::Color(170, 170, 170));
+    title.setPosition({x, y});
+    target.draw(title);
+
+    if (!info)
+        return;
+
+    for (const auto& line : info->lines) {
+        y += 28.f;
+
+        // Score plus the first few moves is what fits in the column
+        std::string text = formatScore(line.score);
+        for (size_t i = 0; i < line.pv.size() && i < 4; ++i)
+            text += " " + squareName(line.pv[i].from) + squareName(line.pv[i].to);
+
+        sf::Text row(font, text, 16);
+        row.setPosition({x, y});
+        target.draw(row);
+    }
+}
+
+
+sf::Vector2f AnalysisView::squareCenter(int square) const {
+    int file = square % 8;
+    int rank = square / 8;
+    return {(file + 0.5f) * tileSize, (7 - rank + 0.5f) * tileSize};
+}
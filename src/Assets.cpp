@@ -0,0 +1,87 @@
+#include <stdexcept>
+#include "Assets.h"
+
+#ifdef CHESS_EMBED_ASSETS
+#include "EmbeddedAssets.h"
+#endif
+
+Assets& Assets::instance() {
+    static Assets assets;
+    return assets;
+}
+
+
+bool Assets::findEmbedded(const std::string& path, const void*& data, std::size_t& size) {
+#ifdef CHESS_EMBED_ASSETS
+    for (std::size_t i = 0; i < embeddedAssetCount; ++i) {
+        if (path == embeddedAssets[i].path) {
+            data = embeddedAssets[i].data;
+            size = embeddedAssets[i].size;
+            return true;
+        }
+    }
+#else
+    (void)path;
+    (void)data;
+    (void)size;
+#endif
+    return false;
+}
+
+
+const sf::Texture& Assets::texture(const std::string& path) {
+    auto it = textures.find(path);
+    if (it != textures.end())
+        return it->second;
+
+    sf::Texture tex;
+    const void* data = nullptr;
+    std::size_t size = 0;
+
+    bool loaded = findEmbedded(path, data, size)
+                ? tex.loadFromMemory(data, size)
+                : tex.loadFromFile(path);
+    if (!loaded)
+        throw std::runtime_error("Failed to load: " + path);
+
+    return textures.emplace(path, std::move(tex)).first->second;
+}
+
+
+const sf::Image& Assets::image(const std::string& path) {
+    auto it = images.find(path);
+    if (it != images.end())
+        return it->second;
+
+    sf::Image img;
+    const void* data = nullptr;
+    std::size_t size = 0;
+
+    bool loaded = findEmbedded(path, data, size)
+                ? img.loadFromMemory(data, size)
+                : img.loadFromFile(path);
+    if (!loaded)
+        throw std::runtime_error("Failed to load: " + path);
+
+    return images.emplace(path, std::move(img)).first->second;
+}
+
+
+const sf::Font& Assets::font(const std::string& path) {
+    auto it = fonts.find(path);
+    if (it != fonts.end())
+        return it->second;
+
+    // Embedded data is static, so the font may keep pointing at it
+    sf::Font fnt;
+    const void* data = nullptr;
+    std::size_t size = 0;
+
+    bool loaded = findEmbedded(path, data, size)
+                ? fnt.openFromMemory(data, size)
+                : fnt.openFromFile(path);
+    if (!loaded)
+        throw std::runtime_error("Failed to load: " + path);
+
+    return fonts.emplace(path, std::move(fnt)).first->second;
+}
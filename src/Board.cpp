@@ -1,7 +1,102 @@
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 #include <cctype>
+#include "Attacks.h"
 #include "Board.h"
 #include "Piece.h"
+#include "Profiler.h"
+
+namespace {
+
+struct ZobristKeys {
+    uint64_t pieces[2][6][64];   // [color][piece type][square]
+    uint64_t castling[16];       // indexed by castlingRights()
+    uint64_t enPassantFile[8];
+    uint64_t blackToMove;
+};
+
+constexpr uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr ZobristKeys makeZobristKeys() {
+    ZobristKeys keys{};
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+
+    for (auto& color : keys.pieces)
+        for (auto& type : color)
+            for (auto& key : type)
+                key = splitMix64(state);
+    for (auto& key : keys.castling)
+        key = splitMix64(state);
+    for (auto& key : keys.enPassantFile)
+        key = splitMix64(state);
+    keys.blackToMove = splitMix64(state);
+
+    return keys;
+}
+
+constexpr ZobristKeys zobrist = makeZobristKeys();
+
+inline uint64_t pieceKey(Piece p, int square) {
+    if (p.type == PieceType::NONE)
+        return 0;
+    return zobrist.pieces[static_cast<int>(p.color)][static_cast<int>(p.type)][square];
+}
+
+inline uint64_t enPassantKey(int epSquare) {
+    return (epSquare == -1) ? 0 : zobrist.enPassantFile[epSquare % 8];
+}
+
+// Whether a leaper move onto `target` belongs to the requested kind
+template <GenType Type>
+inline bool wanted(Piece target, Color us) {
+    if (target.type == PieceType::NONE)
+        return Type != GenType::CAPTURES;
+    return target.color != us && Type != GenType::QUIETS;
+}
+
+// Queen-like directions as rank/file steps, for ray walks from a square
+struct RayDir {
+    int dr;
+    int df;
+    bool diagonal;
+};
+
+constexpr RayDir rayDirs[8] = {
+    {1, 0, false}, {-1, 0, false}, {0, 1, false}, {0, -1, false},
+    {1, 1, true}, {1, -1, true}, {-1, 1, true}, {-1, -1, true}
+};
+
+inline bool slidesAlong(PieceType type, bool diagonal) {
+    return type == PieceType::QUEEN ||
+           type == (diagonal ? PieceType::BISHOP : PieceType::ROOK);
+}
+
+// Per-colour board geometry, so the templated generator and make/unmake
+// fold every colour decision at compile time
+template <Color Us>
+struct Side {
+    static constexpr bool white = (Us == Color::WHITE);
+
+    static constexpr Color them = white ? Color::BLACK : Color::WHITE;
+    static constexpr int index = static_cast<int>(Us);
+
+    static constexpr int forward = white ? 8 : -8;
+    static constexpr int pawnRank = white ? 1 : 6;        // double pushes start here
+    static constexpr int enPassantRank = white ? 4 : 3;   // where our pawn captures e.p.
+    static constexpr int promotionRank = white ? 7 : 0;
+
+    static constexpr int kingStart = white ? 4 : 60;
+    static constexpr int kingsideRook = white ? 7 : 63;
+    static constexpr int queensideRook = white ? 0 : 56;
+};
+
+} // namespace
 
 Board::Board() {
     //set all squares to empty
@@ -34,6 +129,237 @@ Board::Board() {
     }
 
     sideToMove = Color::WHITE;
+    hash = computeHash();
+    pawnHash = computePawnHash();
+}
+
+
+bool Board::loadFen(const std::string& fen) {
+    std::istringstream in(fen);
+    std::string placement, side, castling, enPassant;
+    int halfmoves = 0;
+    in >> placement >> side >> castling >> enPassant >> halfmoves;
+
+    if (placement.empty() || side.empty()) {
+        std::cerr << "Error: loadFen called with incomplete FEN \"" << fen << "\"" << std::endl;
+        return false;
+    }
+
+    Board parsed;
+    for (auto& square : parsed.squares) {
+        square = {Color::WHITE, PieceType::NONE};
+    }
+    parsed.kingSquares = {-1, -1};
+
+    // --- Piece placement, rank 8 first ---
+    int rank = 7;
+    int file = 0;
+    for (char c : placement) {
+        if (c == '/') {
+            --rank;
+            file = 0;
+            continue;
+        }
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            file += c - '0';
+            continue;
+        }
+
+        PieceType type;
+        switch (std::tolower(static_cast<unsigned char>(c))) {
+            case 'p': type = PieceType::PAWN;   break;
+            case 'r': type = PieceType::ROOK;   break;
+            case 'n': type = PieceType::KNIGHT; break;
+            case 'b': type = PieceType::BISHOP; break;
+            case 'q': type = PieceType::QUEEN;  break;
+            case 'k': type = PieceType::KING;   break;
+            default:
+                std::cerr << "Error: loadFen found invalid piece '" << c << "'" << std::endl;
+                return false;
+        }
+        if (rank < 0 || file > 7) {
+            std::cerr << "Error: loadFen placement overflows the board" << std::endl;
+            return false;
+        }
+
+        Color color = std::isupper(static_cast<unsigned char>(c)) ? Color::WHITE : Color::BLACK;
+        parsed.squares[rank * 8 + file] = {color, type};
+        if (type == PieceType::KING)
+            parsed.kingSquares[static_cast<int>(color)] = rank * 8 + file;
+        ++file;
+    }
+
+    parsed.sideToMove = (side == "b") ? Color::BLACK : Color::WHITE;
+
+    // --- Castling rights map onto the "has moved" flags ---
+    bool wk = castling.find('K') != std::string::npos;
+    bool wq = castling.find('Q') != std::string::npos;
+    bool bk = castling.find('k') != std::string::npos;
+    bool bq = castling.find('q') != std::string::npos;
+
+    parsed.whiteKingMoved = !wk && !wq;
+    parsed.blackKingMoved = !bk && !bq;
+    parsed.whiteKingsideRookMoved = !wk;
+    parsed.whiteQueensideRookMoved = !wq;
+    parsed.blackKingsideRookMoved = !bk;
+    parsed.blackQueensideRookMoved = !bq;
+
+    // --- En passant: rebuild the double push that allowed it ---
+    if (enPassant.size() == 2 && enPassant != "-") {
+        int epFile = enPassant[0] - 'a';
+        int epRank = enPassant[1] - '1';
+        if (epFile >= 0 && epFile < 8 && (epRank == 2 || epRank == 5)) {
+            Color pusher = (epRank == 2) ? Color::WHITE : Color::BLACK;
+            int dir = (pusher == Color::WHITE) ? 8 : -8;
+            int epSquare = epRank * 8 + epFile;
+
+            parsed.lastMoveFrom = epSquare - dir;
+            parsed.lastMoveTo = epSquare + dir;
+            parsed.lastMovePiece = {pusher, PieceType::PAWN};
+        }
+    }
+
+    parsed.halfmoveClock = halfmoves;
+    parsed.hash = parsed.computeHash();
+    parsed.pawnHash = parsed.computePawnHash();
+
+    *this = parsed;
+    return true;
+}
+
+std::string Board::toFen() const {
+    std::string fen;
+
+    for (int rank = 7; rank >= 0; --rank) {
+        int empty = 0;
+        for (int file = 0; file < 8; ++file) {
+            const Piece& piece = squares[rank * 8 + file];
+            if (piece.type == PieceType::NONE) {
+                ++empty;
+                continue;
+            }
+            if (empty > 0) {
+                fen += char('0' + empty);
+                empty = 0;
+            }
+
+            char symbol = '?';
+            switch (piece.type) {
+                case PieceType::PAWN:   symbol = 'P'; break;
+                case PieceType::ROOK:   symbol = 'R'; break;
+                case PieceType::KNIGHT: symbol = 'N'; break;
+                case PieceType::BISHOP: symbol = 'B'; break;
+                case PieceType::QUEEN:  symbol = 'Q'; break;
+                case PieceType::KING:   symbol = 'K'; break;
+                default: break;
+            }
+            if (piece.color == Color::BLACK) {
+                symbol = std::tolower(symbol);
+            }
+            fen += symbol;
+        }
+        if (empty > 0) {
+            fen += char('0' + empty);
+        }
+        if (rank > 0) {
+            fen += '/';
+        }
+    }
+
+    fen += (sideToMove == Color::WHITE) ? " w " : " b ";
+
+    uint8_t rights = castlingRights();
+    std::string castling;
+    if (rights & WHITE_KINGSIDE)  castling += 'K';
+    if (rights & WHITE_QUEENSIDE) castling += 'Q';
+    if (rights & BLACK_KINGSIDE)  castling += 'k';
+    if (rights & BLACK_QUEENSIDE) castling += 'q';
+    fen += castling.empty() ? "-" : castling;
+
+    int epSquare = enPassantSquare();
+    if (epSquare != -1) {
+        fen += ' ';
+        fen += char('a' + epSquare % 8);
+        fen += char('1' + epSquare / 8);
+    } else {
+        fen += " -";
+    }
+
+    fen += ' ' + std::to_string(halfmoveClock) + " 1";
+    return fen;
+}
+
+uint8_t Board::castlingRights() const {
+    uint8_t rights = 0;
+    if (!whiteKingMoved && !whiteKingsideRookMoved)  rights |= WHITE_KINGSIDE;
+    if (!whiteKingMoved && !whiteQueensideRookMoved) rights |= WHITE_QUEENSIDE;
+    if (!blackKingMoved && !blackKingsideRookMoved)  rights |= BLACK_KINGSIDE;
+    if (!blackKingMoved && !blackQueensideRookMoved) rights |= BLACK_QUEENSIDE;
+    return rights;
+}
+
+uint64_t Board::computeHash() const {
+    uint64_t key = 0;
+    for (int square = 0; square < 64; ++square)
+        key ^= pieceKey(squares[square], square);
+
+    key ^= zobrist.castling[castlingRights()];
+    key ^= enPassantKey(hashedEnPassantSquare());
+    if (sideToMove == Color::BLACK)
+        key ^= zobrist.blackToMove;
+
+    return key;
+}
+
+uint64_t Board::computePawnHash() const {
+    uint64_t key = 0;
+    for (int square = 0; square < 64; ++square) {
+        if (squares[square].type == PieceType::PAWN)
+            key ^= pieceKey(squares[square], square);
+    }
+    return key;
+}
+
+int Board::repetitionCount() const {
+    // Only positions since the last capture or pawn move can repeat, and
+    // only those with the same side to move
+    int count = 0;
+    int size = static_cast<int>(hashHistory.size());
+    int limit = std::min(halfmoveClock, size);
+
+    for (int back = 2; back <= limit; back += 2) {
+        if (hashHistory[size - back] == hash)
+            ++count;
+    }
+    return count;
+}
+
+// The en passant square as far as the hash is concerned: only when a
+// pawn of the side to move could take. Otherwise a double push would
+// make a position that never matches the same one reached later.
+int Board::hashedEnPassantSquare() const {
+    int epSquare = enPassantSquare();
+    if (epSquare == -1)
+        return -1;
+
+    int file = lastMoveTo % 8;
+    for (int side : {-1, 1}) {
+        if (file + side < 0 || file + side > 7)
+            continue;
+        Piece p = squares[lastMoveTo + side];
+        if (p.type == PieceType::PAWN && p.color == sideToMove)
+            return epSquare;
+    }
+    return -1;
+}
+
+int Board::enPassantSquare() const {
+    // Only set right after a double pawn push
+    if (lastMovePiece.type == PieceType::PAWN &&
+        std::abs(lastMoveTo - lastMoveFrom) == 16) {
+        return (lastMoveFrom + lastMoveTo) / 2;
+    }
+    return -1;
 }
 Piece Board::getPiece(int square) const {
     if (square < 0 || square >= 64) {
@@ -47,7 +373,16 @@ void Board::setPiece(int square, Piece p) {
         std::cerr << "Error: setPiece called with invalid square index " << square << std::endl;
         return;
     }
+    hash ^= pieceKey(squares[square], square) ^ pieceKey(p, square);
+    // Only pawn moves, captures of pawns and promotions change pawnHash
+    if (squares[square].type == PieceType::PAWN)
+        pawnHash ^= pieceKey(squares[square], square);
+    if (p.type == PieceType::PAWN)
+        pawnHash ^= pieceKey(p, square);
     squares[square] = p;
+    if (p.type == PieceType::KING)
+        kingSquares[static_cast<int>(p.color)] = square;
+    invalidateAttacks();
 }
 bool Board::isEmpty(int square) const {
     if (square < 0 || square >= 64) {
@@ -86,60 +421,109 @@ void Board::print() const {
 
 std::vector<Move> Board::pseudoLegalMoves(Color side) const {
     std::vector<Move> moves;
+    if (side == Color::WHITE)
+        pseudoLegalMovesFor<Color::WHITE, GenType::ALL>(moves);
+    else
+        pseudoLegalMovesFor<Color::BLACK, GenType::ALL>(moves);
+    return moves;
+}
 
-    for (int square = 0; square < 64; ++square) {
-        Piece p = getPiece(square);
-        if (p.color != side)
-            continue;
 
-        switch (p.type) {
-            case PieceType::PAWN:
-                addPawnMoves(square, side, moves);
-                break;
-            case PieceType::KNIGHT:
-                addKnightMoves(square, side, moves);
-                break;
-            case PieceType::BISHOP:
-                addBishopMoves(square, side, moves);
-                break;
-            case PieceType::ROOK:
-                addRookMoves(square, side, moves);
-                break;
-            case PieceType::QUEEN:
-                addQueenMoves(square, side, moves);
-                break;
-            case PieceType::KING:
-                addKingMoves(square, side, moves);
-                break;
-            default:
-                break;
+void Board::generateMoves(GenType type, std::vector<Move>& moves) const {
+    bool white = sideToMove == Color::WHITE;
+    switch (type) {
+        case GenType::ALL:
+            white ? pseudoLegalMovesFor<Color::WHITE, GenType::ALL>(moves)
+                  : pseudoLegalMovesFor<Color::BLACK, GenType::ALL>(moves);
+            break;
+        case GenType::CAPTURES:
+            white ? pseudoLegalMovesFor<Color::WHITE, GenType::CAPTURES>(moves)
+                  : pseudoLegalMovesFor<Color::BLACK, GenType::CAPTURES>(moves);
+            break;
+        case GenType::QUIETS:
+            white ? pseudoLegalMovesFor<Color::WHITE, GenType::QUIETS>(moves)
+                  : pseudoLegalMovesFor<Color::BLACK, GenType::QUIETS>(moves);
+            break;
+    }
+}
+
+
+bool Board::lookupMove(int from, int to, Move& move) const {
+    if (from < 0 || from >= 64 || to < 0 || to >= 64)
+        return false;
+
+    Piece p = getPiece(from);
+    if (p.type == PieceType::NONE || p.color != sideToMove)
+        return false;
+
+    // Only the one piece's moves are generated, into a buffer kept per
+    // thread so hash-move and killer checks in the search don't allocate
+    thread_local std::vector<Move> moves;
+    moves.clear();
+    if (sideToMove == Color::WHITE)
+        addPieceMoves<Color::WHITE, GenType::ALL>(from, p.type, moves);
+    else
+        addPieceMoves<Color::BLACK, GenType::ALL>(from, p.type, moves);
+
+    for (const auto& m : moves) {
+        if (m.to == to) {
+            move = m;
+            return true;
         }
     }
-    return moves;
+    return false;
 }
 
-void Board::addKnightMoves(int square, Color side, std::vector<Move>& moves) const {
-    static const int knightOffsets[8] = {15, 17, 6, 10, -15, -17, -6, -10};
 
-    int fromRank = square / 8;
-    int fromFile = square % 8;
+template <Color Us, GenType Type>
+void Board::pseudoLegalMovesFor(std::vector<Move>& moves) const {
+    CHESS_PROFILE_SCOPE(PSEUDO_LEGAL_MOVES);
 
-    for (int offset : knightOffsets) {
-        int target = square + offset;
-        if (target < 0 || target >= 64)
+    for (int square = 0; square < 64; ++square) {
+        Piece p = getPiece(square);
+        if (p.color != Us || p.type == PieceType::NONE)
             continue;
 
-        int toRank = target / 8;
-        int toFile = target % 8;
+        addPieceMoves<Us, Type>(square, p.type, moves);
+    }
+}
 
-        int dr = std::abs(fromRank - toRank);
-        int df = std::abs(fromFile - toFile);
 
-        if (!((dr == 2 && df == 1) || (dr == 1 && df == 2)))
-            continue;
+template <Color Us, GenType Type>
+void Board::addPieceMoves(int square, PieceType type, std::vector<Move>& moves) const {
+    switch (type) {
+        case PieceType::PAWN:
+            addPawnMoves<Us, Type>(square, moves);
+            break;
+        case PieceType::KNIGHT:
+            addKnightMoves<Us, Type>(square, moves);
+            break;
+        case PieceType::BISHOP:
+            addBishopMoves<Us, Type>(square, moves);
+            break;
+        case PieceType::ROOK:
+            addRookMoves<Us, Type>(square, moves);
+            break;
+        case PieceType::QUEEN:
+            addQueenMoves<Us, Type>(square, moves);
+            break;
+        case PieceType::KING:
+            addKingMoves<Us, Type>(square, moves);
+            break;
+        default:
+            break;
+    }
+}
+
+template <Color Us, GenType Type>
+void Board::addKnightMoves(int square, std::vector<Move>& moves) const {
+    CHESS_PROFILE_SCOPE(ADD_KNIGHT_MOVES);
+
+    for (uint64_t targets = attacks::knight[square]; targets; ) {
+        int target = attacks::popLsb(targets);
 
         Piece targetPiece = getPiece(target);
-        if (targetPiece.type == PieceType::NONE || targetPiece.color != side) {
+        if (wanted<Type>(targetPiece, Us)) {
             Move m;
             m.from = square;
             m.to = target;
@@ -149,191 +533,95 @@ void Board::addKnightMoves(int square, Color side, std::vector<Move>& moves) con
     }
 }
 
-void Board::addPawnMoves(int square, Color side, std::vector<Move>& moves) const {
-    if (side == Color::WHITE){
+template <Color Us, GenType Type>
+void Board::addPawnMoves(int square, std::vector<Move>& moves) const {
+    CHESS_PROFILE_SCOPE(ADD_PAWN_MOVES);
 
-        int rank = square / 8;
-        int file = square % 8;
+    using S = Side<Us>;
 
-        int forward = square + 8;
-        if (forward < 64 && isEmpty(forward)) {
+    int rank = square / 8;
+    int file = square % 8;
+
+    int forward = square + S::forward;
+    if (forward >= 0 && forward < 64 && isEmpty(forward)) {
+        bool promotion = forward / 8 == S::promotionRank;
+
+        // Pushes to the last rank go with the captures
+        if (promotion ? Type != GenType::QUIETS : Type != GenType::CAPTURES) {
             Move m;
             m.from = square;
             m.to = forward;
-            m.captured = Piece{Color::WHITE, PieceType::NONE};
-            if (m.to/8 == 7) {
-                m.promotion = true;
-            }
+            m.captured = Piece{Us, PieceType::NONE};
+            m.promotion = promotion;
             moves.push_back(m);
-
-            if (rank == 1) {
-                int doubleForward = square + 16;
-                if (doubleForward < 64 && isEmpty(doubleForward)) {
-                    Move m2;
-                    m2.from = square;
-                    m2.to = doubleForward;
-                    m2.captured = Piece{Color::WHITE, PieceType::NONE};
-                    moves.push_back(m2);
-                }
-            }
-        }
-
-        if (file > 0) {
-            int captureLeft = square + 7;
-            if (captureLeft < 64) {
-                Piece target = getPiece(captureLeft);
-                if (target.type != PieceType::NONE && target.color == Color::BLACK) {
-                    Move m;
-                    m.from = square;
-                    m.to = captureLeft;
-                    m.captured = target;
-                    if (m.to/8 == 7) {
-                        m.promotion = true;
-                    }
-                    moves.push_back(m);
-                }
-            }
         }
 
-        if (file < 7) {
-            int captureRight = square + 9;
-            if (captureRight < 64) {
-                Piece target = getPiece(captureRight);
-                if (target.type != PieceType::NONE && target.color == Color::BLACK) {
-                    Move m;
-                    m.from = square;
-                    m.to = captureRight;
-                    m.captured = target;
-                    if (m.to/8 == 7) {
-                        m.promotion = true;
-                    }
-                    moves.push_back(m);
-                }
+        if (Type != GenType::CAPTURES && rank == S::pawnRank) {
+            int doubleForward = forward + S::forward;
+            if (isEmpty(doubleForward)) {
+                Move m2;
+                m2.from = square;
+                m2.to = doubleForward;
+                m2.captured = Piece{Us, PieceType::NONE};
+                moves.push_back(m2);
             }
         }
-        // En passant (WHITE)
-        if (rank == 4) { // pawn must be on 5th rank
-            // Enemy pawn moved last turn
-            if (lastMovePiece.type == PieceType::PAWN &&
-                lastMovePiece.color == Color::BLACK &&
-                lastMoveFrom / 8 == 6 &&
-                lastMoveTo / 8 == 4) {
-
-                // Pawn is to the left
-                if (file > 0 && lastMoveTo == square - 1) {
-                    Move m;
-                    m.from = square;
-                    m.to = square + 7;
-                    m.enPassant = true;
-                    m.captured = lastMovePiece;
-                    moves.push_back(m);
-                }
+    }
 
-                // Pawn is to the right
-                if (file < 7 && lastMoveTo == square + 1) {
-                    Move m;
-                    m.from = square;
-                    m.to = square + 9;
-                    m.enPassant = true;
-                    m.captured = lastMovePiece;
-                    moves.push_back(m);
-                }
-            }
-        }
+    if (Type == GenType::QUIETS)
+        return;
 
-    }
-    else { 
-        int rank = square / 8;
-        int file = square % 8;
+    for (uint64_t targets = attacks::pawn[S::index][square]; targets; ) {
+        int capture = attacks::popLsb(targets);
 
-        int forward = square - 8;
-        if (forward >= 0 && isEmpty(forward)) {
+        Piece target = getPiece(capture);
+        if (target.type != PieceType::NONE && target.color == S::them) {
             Move m;
             m.from = square;
-            m.to = forward;
-            m.captured = Piece{Color::BLACK, PieceType::NONE};
-            if (m.to/8 == 0) {
+            m.to = capture;
+            m.captured = target;
+            if (m.to/8 == S::promotionRank) {
                 m.promotion = true;
             }
             moves.push_back(m);
-
-            if (rank == 6) {
-                int doubleForward = square - 16;
-                if (doubleForward >= 0 && isEmpty(doubleForward)) {
-                    Move m2;
-                    m2.from = square;
-                    m2.to = doubleForward;
-                    m2.captured = Piece{Color::BLACK, PieceType::NONE};
-                    moves.push_back(m2);
-                }
-            }
-        }
-
-        if (file > 0) {
-            int captureLeft = square - 9;
-            if (captureLeft >= 0) {
-                Piece target = getPiece(captureLeft);
-                if (target.type != PieceType::NONE && target.color == Color::WHITE) {
-                    Move m;
-                    m.from = square;
-                    m.to = captureLeft;
-                    m.captured = target;
-                    if (m.to/8 == 0) {
-                        m.promotion = true;
-                    }
-                    moves.push_back(m);
-                }
-            }
         }
+    }
 
-        if (file < 7) {
-            int captureRight = square - 7;
-            if (captureRight >= 0) {
-                Piece target = getPiece(captureRight);
-                if (target.type != PieceType::NONE && target.color == Color::WHITE) {
-                    Move m;
-                    m.from = square;
-                    m.to = captureRight;
-                    m.captured = target;
-                    if (m.to/8 == 0) {
-                        m.promotion = true;
-                    }
-                    moves.push_back(m);
-                }
+    // En passant: our pawn on its fifth rank, enemy pawn just double-pushed
+    if (rank == S::enPassantRank) {
+        if (lastMovePiece.type == PieceType::PAWN &&
+            lastMovePiece.color == S::them &&
+            lastMoveFrom / 8 == Side<S::them>::pawnRank &&
+            lastMoveTo / 8 == S::enPassantRank) {
+
+            // Pawn is to the left
+            if (file > 0 && lastMoveTo == square - 1) {
+                Move m;
+                m.from = square;
+                m.to = square + S::forward - 1;
+                m.enPassant = true;
+                m.captured = lastMovePiece;
+                moves.push_back(m);
             }
-        }
-        // En passant (BLACK)
-        if (rank == 3) { // pawn must be on 4th rank
-            if (lastMovePiece.type == PieceType::PAWN &&
-                lastMovePiece.color == Color::WHITE &&
-                lastMoveFrom / 8 == 1 &&
-                lastMoveTo / 8 == 3) {
-
-                if (file > 0 && lastMoveTo == square - 1) {
-                    Move m;
-                    m.from = square;
-                    m.to = square - 9;
-                    m.enPassant = true;
-                    m.captured = lastMovePiece;
-                    moves.push_back(m);
-                }
 
-                if (file < 7 && lastMoveTo == square + 1) {
-                    Move m;
-                    m.from = square;
-                    m.to = square - 7;
-                    m.enPassant = true;
-                    m.captured = lastMovePiece;
-                    moves.push_back(m);
-                }
+            // Pawn is to the right
+            if (file < 7 && lastMoveTo == square + 1) {
+                Move m;
+                m.from = square;
+                m.to = square + S::forward + 1;
+                m.enPassant = true;
+                m.captured = lastMovePiece;
+                moves.push_back(m);
             }
         }
-
     }
 }
 
 
-void Board::addBishopMoves(int square, Color side, std::vector<Move>& moves) const {
+template <Color Us, GenType Type>
+void Board::addBishopMoves(int square, std::vector<Move>& moves) const {
+    CHESS_PROFILE_SCOPE(ADD_BISHOP_MOVES);
+
     const int directions[4] = { 9, 7, -7, -9 };
 
     for (int dir : directions) {
@@ -351,9 +639,10 @@ void Board::addBishopMoves(int square, Color side, std::vector<Move>& moves) con
             Piece target = getPiece(next);
 
             if (target.type == PieceType::NONE) {
-                moves.push_back({ square, next, Piece{Color::WHITE, PieceType::NONE} });
+                if (Type != GenType::CAPTURES)
+                    moves.push_back({ square, next, Piece{Color::WHITE, PieceType::NONE} });
             } else {
-                if (target.color != side) {
+                if (target.color != Us && Type != GenType::QUIETS) {
                     moves.push_back({ square, next, target });
                 }
                 break;
@@ -365,7 +654,10 @@ void Board::addBishopMoves(int square, Color side, std::vector<Move>& moves) con
 }
 
 
-void Board:: addRookMoves(int square, Color side, std::vector<Move>& moves) const {
+template <Color Us, GenType Type>
+void Board::addRookMoves(int square, std::vector<Move>& moves) const {
+    CHESS_PROFILE_SCOPE(ADD_ROOK_MOVES);
+
     const int directions[4] = { 8, -8, 1, -1 };
 
     for (int dir : directions) {
@@ -383,9 +675,10 @@ void Board:: addRookMoves(int square, Color side, std::vector<Move>& moves) cons
             Piece target = getPiece(next);
 
             if (target.type == PieceType::NONE) {
-                moves.push_back({ square, next, Piece{Color::WHITE, PieceType::NONE} });
+                if (Type != GenType::CAPTURES)
+                    moves.push_back({ square, next, Piece{Color::WHITE, PieceType::NONE} });
             } else {
-                if (target.color != side) {
+                if (target.color != Us && Type != GenType::QUIETS) {
                     moves.push_back({ square, next, target });
                 }
                 break;
@@ -396,33 +689,25 @@ void Board:: addRookMoves(int square, Color side, std::vector<Move>& moves) cons
     }
 }
 
-void Board::addQueenMoves(int square, Color side, std::vector<Move>& moves) const {
-    addBishopMoves(square, side, moves);
-    addRookMoves(square, side, moves);
-}
-
-void Board::addKingMoves(int square, Color side, std::vector<Move>& moves) const {
-    static const int kingOffsets[8] = {8, 7, 9, -8, -7, -9, 1, -1};
-
-    int fromRank = square / 8;
-    int fromFile = square % 8;
+template <Color Us, GenType Type>
+void Board::addQueenMoves(int square, std::vector<Move>& moves) const {
+    CHESS_PROFILE_SCOPE(ADD_QUEEN_MOVES);
 
-    for (int offset : kingOffsets) {
-        int target = square + offset;
-        if (target < 0 || target >= 64)
-            continue;
+    addBishopMoves<Us, Type>(square, moves);
+    addRookMoves<Us, Type>(square, moves);
+}
 
-        int toRank = target / 8;
-        int toFile = target % 8;
+template <Color Us, GenType Type>
+void Board::addKingMoves(int square, std::vector<Move>& moves) const {
+    CHESS_PROFILE_SCOPE(ADD_KING_MOVES);
 
-        int dr = std::abs(fromRank - toRank);
-        int df = std::abs(fromFile - toFile);
+    using S = Side<Us>;
 
-        if (dr > 1 || df > 1)
-            continue;
+    for (uint64_t targets = attacks::king[square]; targets; ) {
+        int target = attacks::popLsb(targets);
 
         Piece targetPiece = getPiece(target);
-        if (targetPiece.type == PieceType::NONE || targetPiece.color != side) {
+        if (wanted<Type>(targetPiece, Us)) {
             Move m;
             m.from = square;
             m.to = target;
@@ -430,115 +715,88 @@ void Board::addKingMoves(int square, Color side, std::vector<Move>& moves) const
             moves.push_back(m);
         }
     }
-    // Castling
-    if (side == Color::WHITE && !whiteKingMoved && square == 4) {
-        // King-side
-        if (!whiteKingsideRookMoved &&
-            getPiece(7).type == PieceType::ROOK &&
-            getPiece(7).color == Color::WHITE &&
-            isEmpty(5) && isEmpty(6) &&
-            !squareAttacked(4, Color::BLACK) &&
-            !squareAttacked(5, Color::BLACK) &&
-            !squareAttacked(6, Color::BLACK)) {
 
-            Move m;
-            m.from = 4;
-            m.to = 6;
-            m.castling = true;
-            moves.push_back(m);
-        }
+    // Castling
+    if (Type == GenType::CAPTURES || square != S::kingStart)
+        return;
 
-        // Queen-side
-        if (!whiteQueensideRookMoved &&
-            getPiece(0).type == PieceType::ROOK &&
-            getPiece(0).color == Color::WHITE &&
-            isEmpty(1) && isEmpty(2) && isEmpty(3) &&
-            !squareAttacked(4, Color::BLACK) &&
-            !squareAttacked(3, Color::BLACK) &&
-            !squareAttacked(2, Color::BLACK)) {
+    if (canCastleKingside<Us>()) {
+        Move m;
+        m.from = S::kingStart;
+        m.to = S::kingStart + 2;
+        m.castling = true;
+        moves.push_back(m);
+    }
 
-            Move m;
-            m.from = 4;
-            m.to = 2;
-            m.castling = true;
-            moves.push_back(m);
-        }
+    if (canCastleQueenside<Us>()) {
+        Move m;
+        m.from = S::kingStart;
+        m.to = S::kingStart - 2;
+        m.castling = true;
+        moves.push_back(m);
     }
+}
 
-    else if (side == Color::BLACK && !blackKingMoved && square == 60) {
-        // King-side
-        if (!blackKingsideRookMoved &&
-            getPiece(63).type == PieceType::ROOK &&
-            getPiece(63).color == Color::BLACK &&
-            isEmpty(61) && isEmpty(62) &&
-            !squareAttacked(60, Color::WHITE) &&
-            !squareAttacked(61, Color::WHITE) &&
-            !squareAttacked(62, Color::WHITE)) {
 
-            Move m;
-            m.from = 60;
-            m.to = 62;
-            m.castling = true;
-            moves.push_back(m);
-        }
+// Full castling legality: rights, rook in place, empty path, and the
+// king neither in check nor passing through or landing on an attack
+template <Color Us>
+bool Board::canCastleKingside() const {
+    using S = Side<Us>;
+    constexpr int k = S::kingStart;
 
-        // Queen-side
-        if (!blackQueensideRookMoved &&
-            getPiece(56).type == PieceType::ROOK &&
-            getPiece(56).color == Color::BLACK &&
-            isEmpty(57) && isEmpty(58) && isEmpty(59) &&
-            !squareAttacked(60, Color::WHITE) &&
-            !squareAttacked(59, Color::WHITE) &&
-            !squareAttacked(58, Color::WHITE)) {
+    bool kingMoved = (Us == Color::WHITE) ? whiteKingMoved : blackKingMoved;
+    bool rookMoved = (Us == Color::WHITE) ? whiteKingsideRookMoved : blackKingsideRookMoved;
 
-            Move m;
-            m.from = 60;
-            m.to = 58;
-            m.castling = true;
-            moves.push_back(m);
-        }
-    }
+    return !kingMoved && !rookMoved &&
+           getPiece(k).type == PieceType::KING &&
+           getPiece(S::kingsideRook).type == PieceType::ROOK &&
+           getPiece(S::kingsideRook).color == Us &&
+           isEmpty(k + 1) && isEmpty(k + 2) &&
+           !(attackedSquares(S::them) & ((1ULL << k) | (1ULL << (k + 1)) | (1ULL << (k + 2))));
+}
 
+
+template <Color Us>
+bool Board::canCastleQueenside() const {
+    using S = Side<Us>;
+    constexpr int k = S::kingStart;
+
+    bool kingMoved = (Us == Color::WHITE) ? whiteKingMoved : blackKingMoved;
+    bool rookMoved = (Us == Color::WHITE) ? whiteQueensideRookMoved : blackQueensideRookMoved;
+
+    return !kingMoved && !rookMoved &&
+           getPiece(k).type == PieceType::KING &&
+           getPiece(S::queensideRook).type == PieceType::ROOK &&
+           getPiece(S::queensideRook).color == Us &&
+           isEmpty(k - 1) && isEmpty(k - 2) && isEmpty(k - 3) &&
+           !(attackedSquares(S::them) & ((1ULL << k) | (1ULL << (k - 1)) | (1ULL << (k - 2))));
 }
 
 bool Board::squareAttacked(int square, Color by) const {
-    int rank = square / 8;
-    int file = square % 8;
+    return (by == Color::WHITE) ? squareAttackedBy<Color::WHITE>(square)
+                                : squareAttackedBy<Color::BLACK>(square);
+}
+
+
+template <Color By>
+bool Board::squareAttackedBy(int square) const {
+    CHESS_PROFILE_SCOPE(SQUARE_ATTACKED);
 
     // ===== PAWN ATTACKS =====
-    if (by == Color::WHITE) {
-        if (file > 0 && square - 9 >= 0) {
-            Piece p = getPiece(square - 9);
-            if (p.type == PieceType::PAWN && p.color == Color::WHITE)
-                return true;
-        }
-        if (file < 7 && square - 7 >= 0) {
-            Piece p = getPiece(square - 7);
-            if (p.type == PieceType::PAWN && p.color == Color::WHITE)
-                return true;
-        }
-    } else {
-        if (file > 0 && square + 7 < 64) {
-            Piece p = getPiece(square + 7);
-            if (p.type == PieceType::PAWN && p.color == Color::BLACK)
-                return true;
-        }
-        if (file < 7 && square + 9 < 64) {
-            Piece p = getPiece(square + 9);
-            if (p.type == PieceType::PAWN && p.color == Color::BLACK)
-                return true;
-        }
+    // A pawn of colour By hits this square from where an opposing pawn
+    // standing here would capture
+    for (uint64_t from = attacks::pawn[Side<Side<By>::them>::index][square]; from; ) {
+        Piece p = getPiece(attacks::popLsb(from));
+        if (p.type == PieceType::PAWN && p.color == By)
+            return true;
     }
 
     // ===== KNIGHTS =====
-    static const int knightOffsets[8] = {15, 17, 6, 10, -15, -17, -6, -10};
-    for (int off : knightOffsets) {
-        int sq = square + off;
-        if (sq >= 0 && sq < 64) {
-            Piece p = getPiece(sq);
-            if (p.type == PieceType::KNIGHT && p.color == by)
-                return true;
-        }
+    for (uint64_t from = attacks::knight[square]; from; ) {
+        Piece p = getPiece(attacks::popLsb(from));
+        if (p.type == PieceType::KNIGHT && p.color == By)
+            return true;
     }
 
     // ===== BISHOPS / QUEENS (diagonals) =====
@@ -554,7 +812,7 @@ bool Board::squareAttacked(int square, Color by) const {
             Piece p = getPiece(nxt);
             if (p.type != PieceType::NONE) {
                 if ((p.type == PieceType::BISHOP || p.type == PieceType::QUEEN)
-                    && p.color == by)
+                    && p.color == By)
                     return true;
                 break;
             }
@@ -575,7 +833,7 @@ bool Board::squareAttacked(int square, Color by) const {
             Piece p = getPiece(nxt);
             if (p.type != PieceType::NONE) {
                 if ((p.type == PieceType::ROOK || p.type == PieceType::QUEEN)
-                    && p.color == by)
+                    && p.color == By)
                     return true;
                 break;
             }
@@ -584,14 +842,10 @@ bool Board::squareAttacked(int square, Color by) const {
     }
 
     // ===== KING =====
-    static const int kingOffsets[8] = {8,7,9,-8,-7,-9,1,-1};
-    for (int off : kingOffsets) {
-        int sq = square + off;
-        if (sq >= 0 && sq < 64) {
-            Piece p = getPiece(sq);
-            if (p.type == PieceType::KING && p.color == by)
-                return true;
-        }
+    for (uint64_t from = attacks::king[square]; from; ) {
+        Piece p = getPiece(attacks::popLsb(from));
+        if (p.type == PieceType::KING && p.color == By)
+            return true;
     }
 
     return false;
@@ -599,50 +853,360 @@ bool Board::squareAttacked(int square, Color by) const {
 
 
 
-bool Board::kingInCheck(Color side) const {
-    int kingSquare = -1;
-    for (int i = 0; i < 64; ++i) {
-        Piece p = getPiece(i);
-        if (p.type == PieceType::KING && p.color == side) {
-            kingSquare = i;
-            break;
+uint64_t Board::attackedSquares(Color by) const {
+    int index = static_cast<int>(by);
+    if (!attackMapsValid[index]) {
+        attackMaps[index] = computeAttacks(by);
+        attackMapsValid[index] = true;
+    }
+    return attackMaps[index];
+}
+
+
+uint64_t Board::computeAttacks(Color by, int ignoreSquare) const {
+    uint64_t attacked = 0;
+
+    auto addSlider = [&](int square, const int* dirs) {
+        for (int i = 0; i < 4; ++i) {
+            int cur = square;
+            while (true) {
+                int nxt = cur + dirs[i];
+                if (nxt < 0 || nxt >= 64 || std::abs((nxt % 8) - (cur % 8)) > 1)
+                    break;
+                attacked |= 1ULL << nxt;
+                if (squares[nxt].type != PieceType::NONE && nxt != ignoreSquare)
+                    break;
+                cur = nxt;
+            }
+        }
+    };
+
+    static const int diagDirs[4] = {9, 7, -7, -9};
+    static const int straightDirs[4] = {8, -8, 1, -1};
+
+    for (int square = 0; square < 64; ++square) {
+        const Piece& p = squares[square];
+        if (p.type == PieceType::NONE || p.color != by)
+            continue;
+
+        switch (p.type) {
+            case PieceType::PAWN:
+                attacked |= attacks::pawn[static_cast<int>(by)][square];
+                break;
+            case PieceType::KNIGHT:
+                attacked |= attacks::knight[square];
+                break;
+            case PieceType::KING:
+                attacked |= attacks::king[square];
+                break;
+            case PieceType::BISHOP:
+                addSlider(square, diagDirs);
+                break;
+            case PieceType::ROOK:
+                addSlider(square, straightDirs);
+                break;
+            case PieceType::QUEEN:
+                addSlider(square, diagDirs);
+                addSlider(square, straightDirs);
+                break;
+            default:
+                break;
         }
     }
 
+    return attacked;
+}
+
+
+void Board::invalidateAttacks() {
+    attackMapsValid = {false, false};
+}
+
+
+bool Board::kingInCheck(Color side) const {
+    return (side == Color::WHITE) ? kingInCheckFor<Color::WHITE>()
+                                  : kingInCheckFor<Color::BLACK>();
+}
+
+
+template <Color Us>
+bool Board::kingInCheckFor() const {
+    CHESS_PROFILE_SCOPE(KING_IN_CHECK);
+
+    constexpr Color them = Side<Us>::them;
+    int king = kingSquare(Us);
+
     // 🚨 SAFETY CHECK
-    if (kingSquare == -1) {
+    if (king == -1) {
         std::cerr << "Error: king not found for side "
-                  << (side == Color::WHITE ? "WHITE" : "BLACK") << std::endl;
+                  << (Us == Color::WHITE ? "WHITE" : "BLACK") << std::endl;
         return false;
     }
 
-    Color opponent = (side == Color::WHITE) ? Color::BLACK : Color::WHITE;
-    return squareAttacked(kingSquare, opponent);
+    // Reuse the attack map when this position already built one
+    if (attackMapsValid[Side<them>::index])
+        return (attackMaps[Side<them>::index] >> king) & 1ULL;
+
+    return squareAttackedBy<them>(king);
+}
+
+
+int Board::countLegalMoves() {
+    return (sideToMove == Color::WHITE) ? countLegalMovesFor<Color::WHITE>()
+                                        : countLegalMovesFor<Color::BLACK>();
+}
+
+
+// Legal move count from checkers and pins alone: no Move is built and
+// nothing is made, except a scratch edit of the squares for en passant.
+template <Color Us>
+int Board::countLegalMovesFor() {
+    CHESS_PROFILE_SCOPE(COUNT_LEGAL_MOVES);
+
+    using S = Side<Us>;
+    constexpr Color them = S::them;
+
+    const int king = kingSquare(Us);
+    Piece empty = { Color::WHITE, PieceType::NONE };
+
+    uint64_t own = 0;
+    uint64_t enemy = 0;
+    for (int square = 0; square < 64; ++square) {
+        if (squares[square].type == PieceType::NONE)
+            continue;
+        if (squares[square].color == Us)
+            own |= 1ULL << square;
+        else
+            enemy |= 1ULL << square;
+    }
+
+    // --- Checkers and pins ---
+    uint64_t checkers = 0;
+    uint64_t evasion = 0;   // where a non-king move must land when in single check
+
+    for (uint64_t from = attacks::knight[king] & enemy; from; ) {
+        int square = attacks::popLsb(from);
+        if (squares[square].type == PieceType::KNIGHT) {
+            checkers |= 1ULL << square;
+            evasion = 1ULL << square;
+        }
+    }
+    for (uint64_t from = attacks::pawn[S::index][king] & enemy; from; ) {
+        int square = attacks::popLsb(from);
+        if (squares[square].type == PieceType::PAWN) {
+            checkers |= 1ULL << square;
+            evasion = 1ULL << square;
+        }
+    }
+
+    uint64_t pinned = 0;
+    int pinCount = 0;
+    std::array<int, 8> pinSquares;
+    std::array<uint64_t, 8> pinRays;   // king to pinner, pinner included
+
+    for (const auto& dir : rayDirs) {
+        uint64_t ray = 0;
+        int blocker = -1;
+
+        for (int r = king / 8 + dir.dr, f = king % 8 + dir.df;
+             r >= 0 && r < 8 && f >= 0 && f < 8; r += dir.dr, f += dir.df) {
+
+            int square = r * 8 + f;
+            ray |= 1ULL << square;
+
+            Piece p = squares[square];
+            if (p.type == PieceType::NONE)
+                continue;
+
+            if (p.color == Us) {
+                if (blocker != -1)
+                    break;
+                blocker = square;
+                continue;
+            }
+
+            if (slidesAlong(p.type, dir.diagonal)) {
+                if (blocker == -1) {
+                    checkers |= 1ULL << square;
+                    evasion = ray;
+                } else {
+                    pinned |= 1ULL << blocker;
+                    pinSquares[pinCount] = blocker;
+                    pinRays[pinCount++] = ray;
+                }
+            }
+            break;
+        }
+    }
+
+    // --- King moves ---
+    // In check the king must not be a blocker of the checking ray
+    uint64_t danger = checkers ? computeAttacks(them, king) : attackedSquares(them);
+    int count = attacks::popCount(attacks::king[king] & ~own & ~danger);
+
+    if (attacks::popCount(checkers) > 1)
+        return count;
+
+    if (!checkers && king == S::kingStart) {
+        count += canCastleKingside<Us>();
+        count += canCastleQueenside<Us>();
+    }
+
+    uint64_t allowed = checkers ? evasion : ~0ULL;
+
+    // --- Everything else ---
+    for (uint64_t pieces = own & ~(1ULL << king); pieces; ) {
+        int square = attacks::popLsb(pieces);
+        uint64_t targets = 0;
+
+        switch (squares[square].type) {
+            case PieceType::PAWN: {
+                int forward = square + S::forward;
+                if (forward >= 0 && forward < 64 && squares[forward].type == PieceType::NONE) {
+                    targets |= 1ULL << forward;
+                    if (square / 8 == S::pawnRank && squares[forward + S::forward].type == PieceType::NONE)
+                        targets |= 1ULL << (forward + S::forward);
+                }
+                targets |= attacks::pawn[S::index][square] & enemy;
+                break;
+            }
+            case PieceType::KNIGHT:
+                targets = attacks::knight[square] & ~own;
+                break;
+            case PieceType::BISHOP:
+            case PieceType::ROOK:
+            case PieceType::QUEEN: {
+                PieceType type = squares[square].type;
+                for (const auto& dir : rayDirs) {
+                    if (!slidesAlong(type, dir.diagonal))
+                        continue;
+                    for (int r = square / 8 + dir.dr, f = square % 8 + dir.df;
+                         r >= 0 && r < 8 && f >= 0 && f < 8; r += dir.dr, f += dir.df) {
+                        int target = r * 8 + f;
+                        if (own & (1ULL << target))
+                            break;
+                        targets |= 1ULL << target;
+                        if (enemy & (1ULL << target))
+                            break;
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        targets &= allowed;
+
+        // A pinned piece may only slide along its pin
+        if (pinned & (1ULL << square)) {
+            for (int i = 0; i < pinCount; ++i) {
+                if (pinSquares[i] == square)
+                    targets &= pinRays[i];
+            }
+        }
+
+        count += attacks::popCount(targets);
+    }
+
+    // --- En passant ---
+    // Rare enough to test directly: both pawns leave the rank, which can
+    // expose the king along it, so check with the capture played out
+    if (lastMovePiece.type == PieceType::PAWN &&
+        lastMovePiece.color == them &&
+        lastMoveFrom / 8 == Side<them>::pawnRank &&
+        lastMoveTo / 8 == S::enPassantRank) {
+
+        int target = lastMoveTo + S::forward;
+        int file = lastMoveTo % 8;
+
+        for (int side : {-1, 1}) {
+            if (file + side < 0 || file + side > 7)
+                continue;
+
+            int from = lastMoveTo + side;
+            Piece pawn = squares[from];
+            if (pawn.type != PieceType::PAWN || pawn.color != Us)
+                continue;
+
+            Piece captured = squares[lastMoveTo];
+            squares[target] = pawn;
+            squares[from] = empty;
+            squares[lastMoveTo] = empty;
+
+            count += !squareAttackedBy<them>(king);
+
+            squares[lastMoveTo] = captured;
+            squares[from] = pawn;
+            squares[target] = empty;
+        }
+    }
+
+    return count;
 }
 
 
 std::vector<Move> Board::legalMoves(Color side) {
     std::vector<Move> legalMoves;
-    auto moves = pseudoLegalMoves(side);
+    if (side == Color::WHITE)
+        legalMovesFor<Color::WHITE>(legalMoves);
+    else
+        legalMovesFor<Color::BLACK>(legalMoves);
+    return legalMoves;
+}
+
+
+template <Color Us>
+void Board::legalMovesFor(std::vector<Move>& legalMoves) {
+    std::vector<Move> moves;
+    pseudoLegalMovesFor<Us, GenType::ALL>(moves);
+
+    uint64_t enemyAttacks = attackedSquares(Side<Us>::them);
+    int king = kingSquare(Us);
+
+    auto savedMaps = attackMaps;
+    auto savedValid = attackMapsValid;
+
+    CHESS_PROFILE_SCOPE(LEGAL_FILTER);
 
-    for (auto move : moves) {           // NOT const (makeMove modifies Move)
-        Board tempboard = *this;
+    for (auto move : moves) {           // NOT const (applyMove modifies Move)
+        // A king can never step onto an attacked square
+        if (move.from == king && !move.castling && ((enemyAttacks >> move.to) & 1ULL))
+            continue;
 
         // Apply the move using full rules
-        tempboard.makeMove(move);
+        applyMoveFor<Us>(move);
 
         // Keep move only if king is safe
-        if (!tempboard.kingInCheck(side)) {
+        if (!kingInCheckFor<Us>()) {
             legalMoves.push_back(move);
         }
+
+        undoMoveFor<Us>(move);
     }
 
-    return legalMoves;
+    // Making moves dropped the maps; they still describe this position
+    attackMaps = savedMaps;
+    attackMapsValid = savedValid;
+}
+
+
+
+void Board::applyMove(Move& m) {
+    if (getPiece(m.from).color == Color::WHITE)
+        applyMoveFor<Color::WHITE>(m);
+    else
+        applyMoveFor<Color::BLACK>(m);
 }
 
 
+template <Color Us>
+void Board::applyMoveFor(Move& m) {
+    CHESS_PROFILE_SCOPE(APPLY_MOVE);
+
+    using S = Side<Us>;
+    using T = Side<S::them>;
 
-void Board::applyMove(Move m) {
     Piece movingPiece = getPiece(m.from);
     Piece empty = { Color::WHITE, PieceType::NONE };
 
@@ -657,87 +1221,64 @@ void Board::applyMove(Move m) {
     m.prevLastMoveFrom = lastMoveFrom;
     m.prevLastMoveTo = lastMoveTo;
     m.prevLastMovePiece = lastMovePiece;
+    m.prevHalfmoveClock = halfmoveClock;
+
+    hashHistory.push_back(hash);
 
-    
+    // Castling and en passant keys are re-added once the move is done
+    hash ^= zobrist.castling[castlingRights()] ^ enPassantKey(hashedEnPassantSquare());
+
+    bool irreversible = movingPiece.type == PieceType::PAWN ||
+                        m.captured.type != PieceType::NONE;
+    halfmoveClock = irreversible ? 0 : halfmoveClock + 1;
+
+    bool& kingMoved = (Us == Color::WHITE) ? whiteKingMoved : blackKingMoved;
+    bool& kingsideRookMoved = (Us == Color::WHITE) ? whiteKingsideRookMoved : blackKingsideRookMoved;
+    bool& queensideRookMoved = (Us == Color::WHITE) ? whiteQueensideRookMoved : blackQueensideRookMoved;
 
     // --- Update castling rights based on moving piece ---
-    if (movingPiece.type == PieceType::KING) {
-        if (movingPiece.color == Color::WHITE)
-            whiteKingMoved = true;
-        else
-            blackKingMoved = true;
-    }
+    if (movingPiece.type == PieceType::KING)
+        kingMoved = true;
 
     if (movingPiece.type == PieceType::ROOK) {
-        if (movingPiece.color == Color::WHITE) {
-            if (m.from == 7) whiteKingsideRookMoved = true;
-            if (m.from == 0) whiteQueensideRookMoved = true;
-        } else {
-            if (m.from == 63)  blackKingsideRookMoved = true;
-            if (m.from == 56)  blackQueensideRookMoved = true;
-        }
+        if (m.from == S::kingsideRook) kingsideRookMoved = true;
+        if (m.from == S::queensideRook) queensideRookMoved = true;
     }
 
     // --- If a rook is captured, lose castling rights ---
     if (m.captured.type == PieceType::ROOK) {
-        if (m.captured.color == Color::WHITE) {
-            if (m.to == 7) whiteKingsideRookMoved = true;
-            if (m.to == 0) whiteQueensideRookMoved = true;
-        } else {
-            if (m.to == 63) blackKingsideRookMoved = true;
-            if (m.to == 56) blackQueensideRookMoved = true;
-        }
+        if (m.to == T::kingsideRook)
+            ((Us == Color::WHITE) ? blackKingsideRookMoved : whiteKingsideRookMoved) = true;
+        if (m.to == T::queensideRook)
+            ((Us == Color::WHITE) ? blackQueensideRookMoved : whiteQueensideRookMoved) = true;
     }
 
     // --- Apply the move ---
+    // (setPiece keeps kingSquares current and drops the cached attack maps)
     if (m.promotion) {
-        setPiece(m.to, { movingPiece.color, PieceType::QUEEN });
+        setPiece(m.to, { Us, PieceType::QUEEN });
         setPiece(m.from, empty);
     }
     else if (m.enPassant) {
         setPiece(m.to, movingPiece);
         setPiece(m.from, empty);
-
-        int capSq = (movingPiece.color == Color::WHITE)
-                    ? m.to - 8
-                    : m.to + 8;
-
-        setPiece(capSq, empty);
+        setPiece(m.to - S::forward, empty);
     }
     else if (m.castling) {
         setPiece(m.to, movingPiece);
         setPiece(m.from, empty);
 
-        // --- WHITE CASTLING ---
-        if (movingPiece.color == Color::WHITE) {
-            // King-side: e1 → g1
-            if (m.to == 6) {
-                whiteKingsideRookMoved = true;
-                setPiece(5, getPiece(7));   // rook h1 → f1
-                setPiece(7, empty);
-            }
-            // Queen-side: e1 → c1
-            else if (m.to == 2) {
-                whiteQueensideRookMoved = true;
-                setPiece(3, getPiece(0));   // rook a1 → d1
-                setPiece(0, empty);
-            }
+        // King-side: rook h → f
+        if (m.to == S::kingStart + 2) {
+            kingsideRookMoved = true;
+            setPiece(S::kingStart + 1, getPiece(S::kingsideRook));
+            setPiece(S::kingsideRook, empty);
         }
-
-        // --- BLACK CASTLING ---
-        else {
-            // King-side: e8 → g8
-            if (m.to == 62) {
-                blackKingsideRookMoved = true;
-                setPiece(61, getPiece(63)); // rook h8 → f8
-                setPiece(63, empty);
-            }
-            // Queen-side: e8 → c8
-            else if (m.to == 58) {
-                blackQueensideRookMoved = true;
-                setPiece(59, getPiece(56)); // rook a8 → d8
-                setPiece(56, empty);
-            }
+        // Queen-side: rook a → d
+        else if (m.to == S::kingStart - 2) {
+            queensideRookMoved = true;
+            setPiece(S::kingStart - 1, getPiece(S::queensideRook));
+            setPiece(S::queensideRook, empty);
         }
     }
     else {
@@ -750,7 +1291,45 @@ void Board::applyMove(Move m) {
     lastMoveTo = m.to;
     lastMovePiece = movingPiece;
 
+    sideToMove = S::them;
+
+    hash ^= zobrist.castling[castlingRights()] ^ enPassantKey(hashedEnPassantSquare());
+    hash ^= zobrist.blackToMove;
+}
+
+
+// Only the side to move and the en passant square change. The clock is
+// reset so that repetition checks never look across the null move: the
+// positions behind it were reached with the other side to move.
+void Board::makeNullMove(Move& m) {
+    m.prevLastMoveFrom = lastMoveFrom;
+    m.prevLastMoveTo = lastMoveTo;
+    m.prevLastMovePiece = lastMovePiece;
+    m.prevHalfmoveClock = halfmoveClock;
+
+    hashHistory.push_back(hash);
+    hash ^= enPassantKey(hashedEnPassantSquare());
+
+    lastMoveFrom = -1;
+    lastMoveTo = -1;
+    lastMovePiece = { Color::WHITE, PieceType::NONE };
+    halfmoveClock = 0;
+
+    sideToMove = (sideToMove == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    hash ^= zobrist.blackToMove;
+}
+
+
+void Board::undoNullMove(const Move& m) {
+    lastMoveFrom  = m.prevLastMoveFrom;
+    lastMoveTo    = m.prevLastMoveTo;
+    lastMovePiece = m.prevLastMovePiece;
+    halfmoveClock = m.prevHalfmoveClock;
+
     sideToMove = (sideToMove == Color::WHITE) ? Color::BLACK : Color::WHITE;
+
+    hash = hashHistory.back();
+    hashHistory.pop_back();
 }
 
 
@@ -762,6 +1341,20 @@ void Board::makeMove(Move m) {
 
 
 void Board::undoMove(const Move& m) {
+    // The moved piece now stands on the target square
+    if (getPiece(m.to).color == Color::WHITE)
+        undoMoveFor<Color::WHITE>(m);
+    else
+        undoMoveFor<Color::BLACK>(m);
+}
+
+
+template <Color Us>
+void Board::undoMoveFor(const Move& m) {
+    CHESS_PROFILE_SCOPE(UNDO_MOVE);
+
+    using S = Side<Us>;
+
     Piece empty = { Color::WHITE, PieceType::NONE };
 
     // --- Restore last-move info ---
@@ -785,39 +1378,24 @@ void Board::undoMove(const Move& m) {
         setPiece(m.to, empty);
 
         // Move rook back
-        if (m.to == 6) {          // White king-side
-            setPiece(7, getPiece(5));
-            setPiece(5, empty);
-        }
-        else if (m.to == 2) {     // White queen-side
-            setPiece(0, getPiece(3));
-            setPiece(3, empty);
-        }
-        else if (m.to == 62) {      // Black king-side
-            setPiece(63, getPiece(61));
-            setPiece(61, empty);
+        if (m.to == S::kingStart + 2) {
+            setPiece(S::kingsideRook, getPiece(S::kingStart + 1));
+            setPiece(S::kingStart + 1, empty);
         }
-        else if (m.to == 58) {      // Black queen-side
-            setPiece(56, getPiece(59));
-            setPiece(59, empty);
+        else if (m.to == S::kingStart - 2) {
+            setPiece(S::queensideRook, getPiece(S::kingStart - 1));
+            setPiece(S::kingStart - 1, empty);
         }
     }
     else if (m.enPassant) {
         // Restore pawn
-        Piece pawn = getPiece(m.to);
-        setPiece(m.from, pawn);
+        setPiece(m.from, getPiece(m.to));
         setPiece(m.to, empty);
-
-        int capSq = (pawn.color == Color::WHITE)
-                    ? m.to - 8
-                    : m.to + 8;
-
-        setPiece(capSq, m.captured);
+        setPiece(m.to - S::forward, m.captured);
     }
     else if (m.promotion) {
         // Restore pawn
-        Piece promoted = getPiece(m.to);
-        setPiece(m.from, { promoted.color, PieceType::PAWN });
+        setPiece(m.from, { Us, PieceType::PAWN });
         setPiece(m.to, m.captured);
     }
     else {
@@ -826,23 +1404,40 @@ void Board::undoMove(const Move& m) {
         setPiece(m.to, m.captured);
     }
 
-    sideToMove = (sideToMove == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    sideToMove = Us;
+
+    // The piece updates above touched the hash; the saved key is exact
+    hash = hashHistory.back();
+    hashHistory.pop_back();
+    halfmoveClock = m.prevHalfmoveClock;
 }
 
 
 uint64_t Board::perft(int depth) {
+    return (sideToMove == Color::WHITE) ? perftFor<Color::WHITE>(depth)
+                                        : perftFor<Color::BLACK>(depth);
+}
+
+
+template <Color Us>
+uint64_t Board::perftFor(int depth) {
     if (depth == 0)
         return 1;
 
+    // Leaves are counted, never made
+    if (depth == 1)
+        return countLegalMovesFor<Us>();
+
     uint64_t nodes = 0;
-    auto moves = legalMoves(sideToMove);
+    std::vector<Move> moves;
+    legalMovesFor<Us>(moves);
 
     for (auto move : moves) {
-        makeMove(move);
+        applyMoveFor<Us>(move);
 
-        nodes += perft(depth - 1);
+        nodes += perftFor<Side<Us>::them>(depth - 1);
 
-        undoMove(move);
+        undoMoveFor<Us>(move);
     }
 
     return nodes;
@@ -854,7 +1449,7 @@ uint64_t Board::perftDivide(int depth) {
     auto moves = legalMoves(sideToMove);
 
     for (auto move : moves) {
-        makeMove(move);
+        applyMove(move);
 
         uint64_t count = perft(depth - 1);
 
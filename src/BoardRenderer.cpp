@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <iostream>
+#include "Assets.h"
+#include "BoardRenderer.h"
+
+namespace {
+
+// Atlas layout order: white pieces then black, each in PieceType order
+const char* pieceFiles[12] = {
+    "whitePawn", "whiteRook", "whiteKnight", "whiteBishop", "whiteQueen", "whiteKing",
+    "blackPawn", "blackRook", "blackKnight", "blackBishop", "blackQueen", "blackKing"
+};
+
+constexpr unsigned WHITE_PATCH = 4;
+
+// Transparent border around every cell. The atlas is smoothed, and a
+// scaled sprite samples a texel past its edge; without the gutter that
+// texel belongs to the neighbouring piece.
+constexpr unsigned GUTTER = 2;
+
+} // namespace
+
+
+BoardRenderer::BoardRenderer(float tileSize)
+    : tileSize(tileSize),
+      boardQuad(sf::PrimitiveType::Triangles),
+      vertices(sf::PrimitiveType::Triangles) {
+}
+
+
+bool BoardRenderer::loadTextures(const std::string& imageDir) {
+    // ---- Board quad, built once ----
+    boardTexture = &Assets::instance().texture(imageDir + "/board.png");
+
+    sf::Vector2f boardSize(tileSize * 8, tileSize * 8);
+    sf::Vector2f boardTexSize(boardTexture->getSize());
+    sf::Vector2f corners[4] = {{0, 0}, {boardSize.x, 0}, {0, boardSize.y}, boardSize};
+    sf::Vector2f texCorners[4] = {{0, 0}, {boardTexSize.x, 0}, {0, boardTexSize.y}, boardTexSize};
+    for (int i : {0, 1, 2, 2, 1, 3})
+        boardQuad.append(sf::Vertex{corners[i], sf::Color::White, texCorners[i]});
+
+    // ---- Piece atlas: 6 columns x 2 rows with gutters, white patch underneath ----
+    std::array<const sf::Image*, 12> images;
+    sf::Vector2u cell(0, 0);
+    for (int i = 0; i < 12; ++i) {
+        images[i] = &Assets::instance().image(imageDir + "/pieces/" + pieceFiles[i] + ".png");
+        cell.x = std::max(cell.x, images[i]->getSize().x);
+        cell.y = std::max(cell.y, images[i]->getSize().y);
+    }
+
+    sf::Vector2u pitch(cell.x + GUTTER, cell.y + GUTTER);
+    unsigned patchTop = GUTTER + pitch.y * 2;
+
+    sf::Image packed({GUTTER + pitch.x * 6, patchTop + WHITE_PATCH}, sf::Color::Transparent);
+    for (int i = 0; i < 12; ++i) {
+        sf::Vector2u dest(GUTTER + pitch.x * (i % 6), GUTTER + pitch.y * (i / 6));
+        if (!packed.copy(*images[i], dest)) {
+            std::cerr << "Failed to pack " << pieceFiles[i] << " into the atlas\n";
+            return false;
+        }
+        pieceRects[i] = sf::IntRect(sf::Vector2i(dest), sf::Vector2i(images[i]->getSize()));
+    }
+
+    for (unsigned y = 0; y < WHITE_PATCH; ++y)
+        for (unsigned x = 0; x < WHITE_PATCH; ++x)
+            packed.setPixel({x, patchTop + y}, sf::Color::White);
+    whiteTexel = sf::Vector2f(WHITE_PATCH / 2.f, patchTop + WHITE_PATCH / 2.f);
+
+    if (!atlas.loadFromImage(packed)) {
+        std::cerr << "Failed to create the piece atlas\n";
+        return false;
+    }
+    atlas.setSmooth(true);
+
+    built = false;
+    return true;
+}
+
+
+void BoardRenderer::update(const Board& board, int selectedSquare,
+                           const std::vector<Move>& selectedMoves) {
+    // The selected moves follow from the position and the selected square
+    if (built && builtKey == board.hashKey() && builtSelection == selectedSquare)
+        return;
+
+    rebuild(board, selectedSquare, selectedMoves);
+}
+
+
+void BoardRenderer::rebuild(const Board& board, int selectedSquare,
+                            const std::vector<Move>& selectedMoves) {
+    vertices.clear();
+
+    sf::Vector2f tile(tileSize, tileSize);
+    sf::Vector2f noTexSize(0, 0);
+
+    // ---- Highlights (untextured, tinted white patch) ----
+    if (selectedSquare != -1) {
+        appendQuad(squareOrigin(selectedSquare), tile, whiteTexel, noTexSize,
+                   sf::Color(255, 255, 0, 100));
+    }
+    for (const auto& m : selectedMoves) {
+        sf::Color color = board.isEmpty(m.to) ? sf::Color(0, 255, 0, 120)
+                                               : sf::Color(255, 0, 0, 120);
+        appendQuad(squareOrigin(m.to), tile, whiteTexel, noTexSize, color);
+    }
+
+    // ---- Pieces ----
+    for (int sq = 0; sq < 64; ++sq) {
+        Piece p = board.getPiece(sq);
+        if (p.type == PieceType::NONE)
+            continue;
+
+        const sf::IntRect& rect = pieceRects[pieceIndex(p)];
+        appendQuad(squareOrigin(sq), tile, sf::Vector2f(rect.position),
+                   sf::Vector2f(rect.size), sf::Color::White);
+    }
+
+    built = true;
+    builtKey = board.hashKey();
+    builtSelection = selectedSquare;
+}
+
+
+void BoardRenderer::draw(sf::RenderTarget& target) const {
+    target.draw(boardQuad, sf::RenderStates(boardTexture));
+    target.draw(vertices, sf::RenderStates(&atlas));
+}
+
+
+void BoardRenderer::appendQuad(sf::Vector2f position, sf::Vector2f size,
+                               sf::Vector2f texPosition, sf::Vector2f texSize,
+                               sf::Color color) {
+    sf::Vector2f corners[4] = {
+        position,
+        {position.x + size.x, position.y},
+        {position.x, position.y + size.y},
+        position + size
+    };
+    sf::Vector2f texCorners[4] = {
+        texPosition,
+        {texPosition.x + texSize.x, texPosition.y},
+        {texPosition.x, texPosition.y + texSize.y},
+        texPosition + texSize
+    };
+
+    for (int i : {0, 1, 2, 2, 1, 3})
+        vertices.append(sf::Vertex{corners[i], color, texCorners[i]});
+}
+
+
+// Rank 8 at the top of the window
+sf::Vector2f BoardRenderer::squareOrigin(int square) const {
+    int file = square % 8;
+    int rank = square / 8;
+    return sf::Vector2f(file * tileSize, (7 - rank) * tileSize);
+}
+
+
+int BoardRenderer::pieceIndex(Piece p) {
+    int index = static_cast<int>(p.type);
+    return (p.color == Color::WHITE) ? index : index + 6;
+}
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <thread>
+#include "DataGen.h"
+#include "Match.h"
+
+PackedPosition PackedPosition::fromBoard(const Board& board, int whiteScore) {
+    PackedPosition packed;
+
+    for (int square = 0; square < 64; ++square) {
+        Piece p = board.getPiece(square);
+        uint8_t code = 0;
+        if (p.type != PieceType::NONE) {
+            code = static_cast<uint8_t>(p.type) + 1;
+            if (p.color == Color::BLACK)
+                code += 8;
+        }
+        packed.squares[square / 2] |= (square % 2 == 0) ? code : uint8_t(code << 4);
+    }
+
+    packed.score = static_cast<int16_t>(std::clamp(whiteScore, -32767, 32767));
+    packed.sideToMove = (board.getSideToMove() == Color::WHITE) ? 0 : 1;
+    packed.castling = board.castlingRights();
+
+    int ep = board.enPassantSquare();
+    packed.epSquare = (ep == -1) ? 64 : static_cast<uint8_t>(ep);
+
+    return packed;
+}
+
+
+void PackedPosition::encode(uint8_t* out) const {
+    std::copy(squares.begin(), squares.end(), out);
+
+    uint16_t rawScore = static_cast<uint16_t>(score);
+    out[32] = static_cast<uint8_t>(rawScore & 0xFF);
+    out[33] = static_cast<uint8_t>(rawScore >> 8);
+    out[34] = static_cast<uint8_t>(result);
+    out[35] = sideToMove;
+    out[36] = castling;
+    out[37] = epSquare;
+    out[38] = 0;
+    out[39] = 0;
+}
+
+
+PackedPosition PackedPosition::decode(const uint8_t* in) {
+    PackedPosition packed;
+
+    std::copy(in, in + 32, packed.squares.begin());
+    packed.score = static_cast<int16_t>(in[32] | (in[33] << 8));
+    packed.result = static_cast<int8_t>(in[34]);
+    packed.sideToMove = in[35];
+    packed.castling = in[36];
+    packed.epSquare = in[37];
+
+    return packed;
+}
+
+
+Piece PackedPosition::pieceAt(int square) const {
+    uint8_t byte = squares[square / 2];
+    uint8_t code = (square % 2 == 0) ? (byte & 0x0F) : (byte >> 4);
+
+    if (code == 0)
+        return {Color::WHITE, PieceType::NONE};
+
+    Color color = (code & 8) ? Color::BLACK : Color::WHITE;
+    return {color, static_cast<PieceType>((code & 7) - 1)};
+}
+
+
+PositionWriter::PositionWriter(const std::string& path, size_t bufferRecords)
+    : out(path, std::ios::binary | std::ios::app),
+      capacity(bufferRecords * PackedPosition::RECORD_SIZE) {
+    buffer.reserve(capacity);
+}
+
+PositionWriter::~PositionWriter() {
+    flush();
+}
+
+bool PositionWriter::write(const PackedPosition& position) {
+    size_t offset = buffer.size();
+    buffer.resize(offset + PackedPosition::RECORD_SIZE);
+    position.encode(buffer.data() + offset);
+
+    if (buffer.size() >= capacity)
+        return flush();
+    return static_cast<bool>(out);
+}
+
+bool PositionWriter::flush() {
+    if (!buffer.empty()) {
+        out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+        out.flush();
+        buffer.clear();
+    }
+    return static_cast<bool>(out);
+}
+
+
+PositionReader::PositionReader(const std::string& path)
+    : in(path, std::ios::binary) {
+}
+
+bool PositionReader::next(PackedPosition& position) {
+    uint8_t record[PackedPosition::RECORD_SIZE];
+    if (!in.read(reinterpret_cast<char*>(record), sizeof(record)))
+        return false;
+
+    position = PackedPosition::decode(record);
+    return true;
+}
+
+
+DataGenerator::DataGenerator(const DataGenConfig& config)
+    : config(config) {
+}
+
+
+uint64_t DataGenerator::run() {
+    written = 0;
+
+    int threads = config.threads;
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Generating " << config.positions << " positions on "
+              << threads << " threads into " << config.outputPrefix << "_*.bin\n";
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i)
+        pool.emplace_back(&DataGenerator::worker, this, i);
+    for (auto& t : pool)
+        t.join();
+
+    if (failed) {
+        std::cerr << "Error: stopped after " << written
+                  << " positions; the shards are incomplete" << std::endl;
+        return written;
+    }
+
+    std::cout << "Wrote " << written << " positions" << std::endl;
+    return written;
+}
+
+
+void DataGenerator::fail(const std::string& path) {
+    failed = true;
+    std::lock_guard<std::mutex> lock(printMutex);
+    std::cerr << "Error: could not write shard " << path << std::endl;
+}
+
+
+void DataGenerator::worker(int index) {
+    std::string path = config.outputPrefix + "_" + std::to_string(index) + ".bin";
+    PositionWriter writer(path);
+    if (!writer.isOpen()) {
+        fail(path);
+        return;
+    }
+
+    std::mt19937_64 rng(config.seed * 0x9E3779B97F4A7C15ULL + index);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+    Search search(config.search);
+    std::vector<PackedPosition> samples;
+
+    while (written < config.positions && !failed) {
+        GameState game;
+        GameAdjudicator adjudicator(config.maxPlies);
+        GameOutcome outcome = GameOutcome::DRAW;
+        samples.clear();
+
+        for (int ply = 0; !adjudicator.isOver(game, outcome); ++ply) {
+            Color side = game.getSideToMove();
+            Move move;
+
+            if (ply < config.randomPlies) {
+                const auto& moves = game.legalMoves();
+                std::uniform_int_distribution<size_t> pick(0, moves.size() - 1);
+                move = moves[pick(rng)];
+            }
+            else {
+                SearchResult result = search.think(game.getBoard());
+                if (!result.hasMove)
+                    break;
+                move = result.bestMove;
+
+                // Quiet: not in check, no tactics pending in the best line,
+                // and not a forced mate
+                bool quiet = !game.inCheck() && isQuiet(move) &&
+                             std::abs(result.score) < MATE_SCORE - MAX_PLY;
+
+                if (ply >= config.minPly && quiet && coin(rng) < config.sampleRate) {
+                    int whiteScore = (side == Color::WHITE) ? result.score : -result.score;
+                    samples.push_back(PackedPosition::fromBoard(game.getBoard(), whiteScore));
+                }
+            }
+
+            adjudicator.recordMove();
+            game.makeMove(move);
+        }
+
+        // Labels are only known once the game is over
+        int8_t label = 0;
+        if (outcome == GameOutcome::WHITE_WIN) label = 1;
+        if (outcome == GameOutcome::BLACK_WIN) label = -1;
+
+        for (auto& sample : samples) {
+            sample.result = label;
+            if (!writer.write(sample)) {
+                fail(path);
+                return;
+            }
+        }
+
+        uint64_t before = written.fetch_add(samples.size());
+        uint64_t after = before + samples.size();
+        if (after / 10000 != before / 10000) {
+            std::lock_guard<std::mutex> lock(printMutex);
+            std::cout << "Positions: " << after << std::endl;
+        }
+    }
+
+    if (!writer.flush())
+        fail(path);
+}
@@ -0,0 +1,100 @@
+#include "Assets.h"
+#include "EndGamePopup.h"
+#include "GameScene.h"
+
+namespace {
+
+const char* resultMessage(GameResult result) {
+    switch (result) {
+        case GameResult::WHITE_WINS:      return "White wins!";
+        case GameResult::BLACK_WINS:      return "Black wins!";
+        case GameResult::DRAW_REPETITION: return "Draw by repetition!";
+        case GameResult::DRAW_FIFTY_MOVE: return "50-move draw!";
+        default:                          return "Stalemate!";
+    }
+}
+
+} // namespace
+
+
+EndGamePopup::EndGamePopup(SceneStack& stack, GameScene& game, GameResult result,
+                           sf::Vector2u windowSize)
+    : Scene(stack),
+      game(game),
+      overlay(sf::Vector2f(windowSize)),
+      popup({500.f, 300.f}),
+      msg(Assets::instance().font("fonts/font.ttf"), resultMessage(result), 36),
+      playAgainBtn({180.f, 50.f}),
+      homeBtn({180.f, 50.f}),
+      playText(Assets::instance().font("fonts/font.ttf"), "Play Again", 20),
+      homeText(Assets::instance().font("fonts/font.ttf"), "Home Screen", 20) {
+
+    // --- Dark overlay ---
+    overlay.setFillColor(sf::Color(0, 0, 0, 150));
+
+    // --- Popup box ---
+    popup.setFillColor(sf::Color::White);
+    popup.setPosition({
+        windowSize.x / 2.f - 250.f,
+        windowSize.y / 2.f - 150.f
+    });
+
+    // --- Text ---
+    msg.setFillColor(sf::Color::Black);
+    msg.setPosition({
+        popup.getPosition().x + 130.f,
+        popup.getPosition().y + 40.f
+    });
+
+    // --- Buttons ---
+    playAgainBtn.setPosition({
+        popup.getPosition().x + 60.f,
+        popup.getPosition().y + 180.f
+    });
+    homeBtn.setPosition({
+        popup.getPosition().x + 260.f,
+        popup.getPosition().y + 180.f
+    });
+    playAgainBtn.setFillColor(sf::Color(200, 200, 200));
+    homeBtn.setFillColor(sf::Color(200, 200, 200));
+
+    playText.setPosition(playAgainBtn.getPosition() + sf::Vector2f(20, 10));
+    homeText.setPosition(homeBtn.getPosition() + sf::Vector2f(20, 10));
+}
+
+
+void EndGamePopup::handleEvent(const sf::Event& event) {
+    if (const auto* key = event.getIf<sf::Event::KeyPressed>()) {
+        if (key->code == sf::Keyboard::Key::Left) {
+            stack.pop();
+            game.undoMove();
+        }
+        return;
+    }
+
+    const auto* mouse = event.getIf<sf::Event::MouseButtonReleased>();
+    if (!mouse || mouse->button != sf::Mouse::Button::Left)
+        return;
+
+    sf::Vector2f mp(mouse->position);
+
+    if (playAgainBtn.getGlobalBounds().contains(mp)) {
+        stack.pop();
+        game.restart();
+    }
+    else if (homeBtn.getGlobalBounds().contains(mp)) {
+        stack.pop();   // popup
+        stack.pop();   // game, back to the menu
+    }
+}
+
+
+void EndGamePopup::draw(sf::RenderTarget& target) {
+    target.draw(overlay);
+    target.draw(popup);
+    target.draw(msg);
+    target.draw(playAgainBtn);
+    target.draw(homeBtn);
+    target.draw(playText);
+    target.draw(homeText);
+}
@@ -0,0 +1,358 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "EpdSolver.h"
+
+namespace {
+
+std::string trim(const std::string& s) {
+    size_t first = s.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos)
+        return "";
+    size_t last = s.find_last_not_of(" \t\r\n");
+    return s.substr(first, last - first + 1);
+}
+
+bool sameSquares(const Move& a, const Move& b) {
+    return a.from == b.from && a.to == b.to;
+}
+
+bool contains(const std::vector<Move>& moves, const Move& m) {
+    return std::any_of(moves.begin(), moves.end(),
+                       [&](const Move& other) { return sameSquares(m, other); });
+}
+
+} // namespace
+
+
+std::vector<EpdPosition> loadEpd(const std::string& path) {
+    std::vector<EpdPosition> positions;
+
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Error: could not open EPD suite " << path << std::endl;
+        return positions;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+
+        std::istringstream in(line);
+        std::string placement, side, castling, enPassant;
+        if (!(in >> placement >> side >> castling >> enPassant) || placement[0] == '#')
+            continue;
+
+        EpdPosition position;
+        position.fen = placement + ' ' + side + ' ' + castling + ' ' + enPassant + " 0 1";
+
+        // Opcodes: "bm Nf3 Qd4; am e4; id \"WAC.001\";"
+        std::string rest;
+        std::getline(in, rest);
+        std::istringstream ops(rest);
+        std::string op;
+        while (std::getline(ops, op, ';')) {
+            std::istringstream fields(trim(op));
+            std::string opcode;
+            fields >> opcode;
+
+            if (opcode == "bm" || opcode == "am") {
+                auto& list = (opcode == "bm") ? position.bestMoves : position.avoidMoves;
+                std::string san;
+                while (fields >> san)
+                    list.push_back(san);
+            } else if (opcode == "id") {
+                std::string id;
+                std::getline(fields, id);
+                id = trim(id);
+                if (id.size() >= 2 && id.front() == '"' && id.back() == '"')
+                    id = id.substr(1, id.size() - 2);
+                position.id = id;
+            }
+        }
+
+        if (position.bestMoves.empty() && position.avoidMoves.empty())
+            continue;
+        if (position.id.empty())
+            position.id = path + ":" + std::to_string(lineNumber);
+
+        positions.push_back(position);
+    }
+
+    return positions;
+}
+
+
+bool parseSan(const Board& position, const std::string& text, Move& move) {
+    std::string san = text;
+    while (!san.empty() && std::strchr("+#!?", san.back()))
+        san.pop_back();
+    if (san.size() < 2)
+        return false;
+
+    Board board = position;
+    auto moves = board.legalMoves(board.getSideToMove());
+
+    // ---------- CASTLING ----------
+    if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+        bool queenside = san.size() == 5;
+        for (const auto& m : moves) {
+            if (m.castling && (m.to < m.from) == queenside) {
+                move = m;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ---------- PIECE ----------
+    PieceType type = PieceType::PAWN;
+    size_t start = 0;
+    switch (san[0]) {
+        case 'K': type = PieceType::KING;   start = 1; break;
+        case 'Q': type = PieceType::QUEEN;  start = 1; break;
+        case 'R': type = PieceType::ROOK;   start = 1; break;
+        case 'B': type = PieceType::BISHOP; start = 1; break;
+        case 'N': type = PieceType::KNIGHT; start = 1; break;
+        default: break;
+    }
+
+    // ---------- PROMOTION ("e8=Q" or "e8Q") ----------
+    bool promotion = false;
+    size_t equals = san.find('=');
+    if (equals != std::string::npos) {
+        if (san.substr(equals + 1) != "Q")
+            return false;
+        promotion = true;
+        san.erase(equals);
+    } else if (type == PieceType::PAWN && std::isupper(static_cast<unsigned char>(san.back()))) {
+        if (san.back() != 'Q')
+            return false;
+        promotion = true;
+        san.pop_back();
+    }
+
+    // ---------- TARGET AND DISAMBIGUATION ----------
+    if (san.size() < start + 2)
+        return false;
+    char toFile = san[san.size() - 2];
+    char toRank = san[san.size() - 1];
+    if (toFile < 'a' || toFile > 'h' || toRank < '1' || toRank > '8')
+        return false;
+    int target = (toRank - '1') * 8 + (toFile - 'a');
+
+    int fromFile = -1;
+    int fromRank = -1;
+    for (size_t i = start; i < san.size() - 2; ++i) {
+        char c = san[i];
+        if (c >= 'a' && c <= 'h')      fromFile = c - 'a';
+        else if (c >= '1' && c <= '8') fromRank = c - '1';
+        else if (c != 'x' && c != '-') return false;
+    }
+
+    // Exactly one legal move may fit, or the SAN is ambiguous
+    int matches = 0;
+    for (const auto& m : moves) {
+        if (m.to != target || m.promotion != promotion ||
+            board.getPiece(m.from).type != type)
+            continue;
+        if ((fromFile != -1 && m.from % 8 != fromFile) ||
+            (fromRank != -1 && m.from / 8 != fromRank))
+            continue;
+
+        move = m;
+        ++matches;
+    }
+    return matches == 1;
+}
+
+
+EpdSolver::EpdSolver(const EpdConfig& config) : config(config) {
+}
+
+
+std::vector<EpdResult> EpdSolver::solve(const std::vector<EpdPosition>& positions) {
+    std::vector<EpdResult> results(positions.size());
+
+    int threads = config.threads;
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    nextPosition = 0;
+    finished = 0;
+    total = positions.size();
+
+    if (config.smp) {
+        for (size_t i = 0; i < positions.size(); ++i) {
+            results[i] = solveOne(positions[i], threads);
+            report(positions[i], results[i]);
+        }
+        return results;
+    }
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            while (true) {
+                size_t i = nextPosition++;
+                if (i >= positions.size())
+                    return;
+                results[i] = solveOne(positions[i], 1);
+                report(positions[i], results[i]);
+            }
+        });
+    }
+    for (auto& thread : pool)
+        thread.join();
+
+    return results;
+}
+
+
+EpdResult EpdSolver::solveOne(const EpdPosition& position, int threads) {
+    using clock = std::chrono::steady_clock;
+
+    EpdResult result;
+
+    Board board;
+    if (!board.loadFen(position.fen))
+        return result;
+
+    std::vector<Move> best, avoid;
+    for (const auto& san : position.bestMoves) {
+        Move m;
+        if (!parseSan(board, san, m)) {
+            std::cerr << "Error: " << position.id << ": cannot read bm " << san << std::endl;
+            return result;
+        }
+        best.push_back(m);
+    }
+    for (const auto& san : position.avoidMoves) {
+        Move m;
+        if (!parseSan(board, san, m)) {
+            std::cerr << "Error: " << position.id << ": cannot read am " << san << std::endl;
+            return result;
+        }
+        avoid.push_back(m);
+    }
+    result.valid = true;
+
+    auto isRight = [&](const Move& m) {
+        return (best.empty() || contains(best, m)) && !contains(avoid, m);
+    };
+
+    SearchConfig searchConfig;
+    searchConfig.maxDepth = MAX_PLY - 1;
+    searchConfig.moveTimeMs = config.timeMs;
+
+    auto table = std::make_shared<TranspositionTable>(config.hashMb);
+    std::atomic<bool> stop{false};
+
+    // Helpers only fill the shared table; the main search decides
+    SearchConfig helperConfig = searchConfig;
+    helperConfig.moveTimeMs = 0;
+    std::vector<std::thread> helpers;
+    for (int i = 1; i < threads; ++i) {
+        helpers.emplace_back([&]() {
+            Search helper(helperConfig, table);
+            helper.setStopFlag(&stop);
+            helper.think(board);
+        });
+    }
+
+    auto start = clock::now();
+    bool right = false;
+
+    Search search(searchConfig, table);
+    search.setIterationCallback([&](const SearchResult& iteration) {
+        bool now = isRight(iteration.bestMove);
+        if (now && !right) {
+            result.solveMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            result.solveNodes = iteration.nodes;
+            result.solveDepth = iteration.depth;
+        }
+        right = now;
+        result.finalMove = iteration.bestMove;
+        result.finalDepth = iteration.depth;
+    });
+    search.think(board);
+
+    stop = true;
+    for (auto& helper : helpers)
+        helper.join();
+
+    result.solved = right;
+    return result;
+}
+
+
+void EpdSolver::report(const EpdPosition& position, const EpdResult& result) {
+    std::lock_guard<std::mutex> lock(printMutex);
+
+    std::cout << "[" << ++finished << "/" << total << "] " << position.id << ": ";
+    if (!result.valid)
+        std::cout << "skipped\n";
+    else if (result.solved)
+        std::cout << "solved in " << std::fixed << std::setprecision(3) << result.solveMs / 1000.0
+                  << " s, depth " << result.solveDepth << ", " << result.solveNodes << " nodes\n";
+    else
+        std::cout << "not solved, played " << Board().moveToString(result.finalMove)
+                  << " at depth " << result.finalDepth << "\n";
+    std::cout.flush();
+}
+
+
+void EpdSolver::printSummary(std::ostream& out, const std::string& suite,
+                             const std::vector<EpdPosition>& positions,
+                             const std::vector<EpdResult>& results,
+                             const std::vector<int>& limitsMs) {
+    size_t valid = 0;
+    std::vector<double> times;
+    for (const auto& result : results) {
+        valid += result.valid;
+        if (result.solved)
+            times.push_back(result.solveMs);
+    }
+    std::sort(times.begin(), times.end());
+
+    out << "\n" << suite << ": " << valid << " positions";
+    if (valid != positions.size())
+        out << " (" << positions.size() - valid << " skipped)";
+    out << "\n";
+
+    for (int limit : limitsMs) {
+        size_t solved = std::upper_bound(times.begin(), times.end(), static_cast<double>(limit))
+                      - times.begin();
+        out << "  " << std::setw(7) << limit << " ms  " << std::setw(5) << solved << "/" << valid
+            << "  " << std::fixed << std::setprecision(1)
+            << (valid ? 100.0 * solved / valid : 0.0) << "%\n";
+    }
+
+    if (!times.empty()) {
+        double sum = 0.0;
+        for (double t : times)
+            sum += t;
+        out << "  time to solution: median " << std::fixed << std::setprecision(1)
+            << times[times.size() / 2] << " ms, mean " << sum / times.size() << " ms\n";
+    }
+
+    std::vector<std::string> failed;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].valid && !results[i].solved)
+            failed.push_back(positions[i].id);
+    }
+    if (!failed.empty()) {
+        out << "  unsolved:";
+        for (const auto& id : failed)
+            out << " " << id;
+        out << "\n";
+    }
+    out.flush();
+}
@@ -0,0 +1,259 @@
+#include "Attacks.h"
+#include "Evaluation.h"
+
+namespace {
+
+// Piece-square tables are written rank 8 first, as seen from White's side.
+const int pawnTable[64] = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+     50,  50,  50,  50,  50,  50,  50,  50,
+     10,  10,  20,  30,  30,  20,  10,  10,
+      5,   5,  10,  25,  25,  10,   5,   5,
+      0,   0,   0,  20,  20,   0,   0,   0,
+      5,  -5, -10,   0,   0, -10,  -5,   5,
+      5,  10,  10, -20, -20,  10,  10,   5,
+      0,   0,   0,   0,   0,   0,   0,   0
+};
+
+const int knightTable[64] = {
+    -50, -40, -30, -30, -30, -30, -40, -50,
+    -40, -20,   0,   0,   0,   0, -20, -40,
+    -30,   0,  10,  15,  15,  10,   0, -30,
+    -30,   5,  15,  20,  20,  15,   5, -30,
+    -30,   0,  15,  20,  20,  15,   0, -30,
+    -30,   5,  10,  15,  15,  10,   5, -30,
+    -40, -20,   0,   5,   5,   0, -20, -40,
+    -50, -40, -30, -30, -30, -30, -40, -50
+};
+
+const int bishopTable[64] = {
+    -20, -10, -10, -10, -10, -10, -10, -20,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+    -10,   0,   5,  10,  10,   5,   0, -10,
+    -10,   5,   5,  10,  10,   5,   5, -10,
+    -10,   0,  10,  10,  10,  10,   0, -10,
+    -10,  10,  10,  10,  10,  10,  10, -10,
+    -10,   5,   0,   0,   0,   0,   5, -10,
+    -20, -10, -10, -10, -10, -10, -10, -20
+};
+
+const int rookTable[64] = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+      5,  10,  10,  10,  10,  10,  10,   5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+      0,   0,   0,   5,   5,   0,   0,   0
+};
+
+const int queenTable[64] = {
+    -20, -10, -10,  -5,  -5, -10, -10, -20,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+    -10,   0,   5,   5,   5,   5,   0, -10,
+     -5,   0,   5,   5,   5,   5,   0,  -5,
+      0,   0,   5,   5,   5,   5,   0,  -5,
+    -10,   5,   5,   5,   5,   5,   0, -10,
+    -10,   0,   5,   0,   0,   0,   0, -10,
+    -20, -10, -10,  -5,  -5, -10, -10, -20
+};
+
+const int kingTable[64] = {
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -20, -30, -30, -40, -40, -30, -30, -20,
+    -10, -20, -20, -20, -20, -20, -20, -10,
+     20,  20,   0,   0,   0,   0,  20,  20,
+     20,  30,  10,   0,   0,  10,  30,  20
+};
+
+int pieceSquareValue(Piece p, int square) {
+    int rank = square / 8;
+    int file = square % 8;
+
+    // Tables are stored rank 8 first; mirror the rank for Black.
+    int index = (p.color == Color::WHITE)
+                ? (7 - rank) * 8 + file
+                : rank * 8 + file;
+
+    switch (p.type) {
+        case PieceType::PAWN:   return pawnTable[index];
+        case PieceType::KNIGHT: return knightTable[index];
+        case PieceType::BISHOP: return bishopTable[index];
+        case PieceType::ROOK:   return rookTable[index];
+        case PieceType::QUEEN:  return queenTable[index];
+        case PieceType::KING:   return kingTable[index];
+        default:                return 0;
+    }
+}
+
+// ---------- PAWN STRUCTURE ----------
+
+constexpr int doubledPenalty = 12;    // per pawn beyond the first on a file
+constexpr int isolatedPenalty = 15;
+constexpr int backwardPenalty = 8;
+constexpr int passedBonus[8] = {0, 5, 10, 20, 35, 60, 100, 0};   // by relative rank
+constexpr int shieldBonus[3] = {10, 5, -10};   // pawn one ahead, two ahead, none
+
+constexpr uint64_t fileMask(int file) {
+    return 0x0101010101010101ULL << file;
+}
+
+constexpr uint64_t adjacentFiles(int file) {
+    return (file > 0 ? fileMask(file - 1) : 0) | (file < 7 ? fileMask(file + 1) : 0);
+}
+
+// Squares strictly ahead of `square` from Us's side, on the given files
+constexpr uint64_t aheadOf(Color us, int square, uint64_t files) {
+    int rank = square / 8;
+    uint64_t ranks = (us == Color::WHITE)
+                     ? (rank < 7 ? ~0ULL << ((rank + 1) * 8) : 0)
+                     : (rank > 0 ? ~0ULL >> ((8 - rank) * 8) : 0);
+    return ranks & files;
+}
+
+int relativeRank(Color us, int square) {
+    return (us == Color::WHITE) ? square / 8 : 7 - square / 8;
+}
+
+// Structure score of one side's pawns, and its passed pawns
+int pawnStructure(Color us, const uint64_t (&pawns)[2], uint64_t& passed) {
+    int ui = static_cast<int>(us);
+    uint64_t ours = pawns[ui];
+    uint64_t theirs = pawns[1 - ui];
+    int forward = (us == Color::WHITE) ? 8 : -8;
+
+    int score = 0;
+    passed = 0;
+
+    for (int file = 0; file < 8; ++file) {
+        int count = attacks::popCount(ours & fileMask(file));
+        if (count > 1)
+            score -= doubledPenalty * (count - 1);
+    }
+
+    for (uint64_t bb = ours; bb; ) {
+        int square = attacks::popLsb(bb);
+        int file = square % 8;
+
+        bool isolated = (ours & adjacentFiles(file)) == 0;
+        if (isolated)
+            score -= isolatedPenalty;
+
+        if ((theirs & aheadOf(us, square, fileMask(file) | adjacentFiles(file))) == 0) {
+            passed |= 1ULL << square;
+            score += passedBonus[relativeRank(us, square)];
+        }
+
+        // Backward: no neighbour level or behind to support its advance,
+        // and an enemy pawn guards the square in front
+        if (!isolated) {
+            uint64_t support = adjacentFiles(file) & ~aheadOf(us, square, ~0ULL);
+            int stop = square + forward;
+            if ((ours & support) == 0 && stop >= 0 && stop < 64 &&
+                (attacks::pawn[ui][stop] & theirs))
+                score -= backwardPenalty;
+        }
+    }
+
+    return score;
+}
+
+const PawnEntry& probePawns(const Board& board, PawnTable& table) {
+    uint64_t key = board.pawnKey();
+    PawnEntry& entry = table.slot(key);
+    if (entry.key == key) {
+        ++table.hits;
+        return entry;
+    }
+    ++table.misses;
+
+    entry.key = key;
+    entry.pawns[0] = entry.pawns[1] = 0;
+    for (int square = 0; square < 64; ++square) {
+        Piece p = board.getPiece(square);
+        if (p.type == PieceType::PAWN)
+            entry.pawns[static_cast<int>(p.color)] |= 1ULL << square;
+    }
+
+    int white = pawnStructure(Color::WHITE, entry.pawns, entry.passed[0]);
+    int black = pawnStructure(Color::BLACK, entry.pawns, entry.passed[1]);
+    entry.score = static_cast<int16_t>(white - black);
+    return entry;
+}
+
+// Terms that mix the cached structure with the rest of the position
+int pawnsInPlay(const Board& board, Color us, const PawnEntry& pawns) {
+    int ui = static_cast<int>(us);
+    int forward = (us == Color::WHITE) ? 8 : -8;
+    int score = 0;
+
+    // A blockaded passer is worth half as much
+    for (uint64_t bb = pawns.passed[ui]; bb; ) {
+        int square = attacks::popLsb(bb);
+        if (!board.isEmpty(square + forward))
+            score -= passedBonus[relativeRank(us, square)] / 2;
+    }
+
+    // Shield in front of a king castled to either wing
+    int king = board.kingSquare(us);
+    int kingFile = king % 8;
+    if (relativeRank(us, king) == 0 && (kingFile <= 2 || kingFile >= 5)) {
+        int first = (kingFile == 0) ? 0 : kingFile - 1;
+        int last = (kingFile == 7) ? 7 : kingFile + 1;
+        for (int file = first; file <= last; ++file) {
+            int oneAhead = king - kingFile + file + forward;
+            if (pawns.pawns[ui] & (1ULL << oneAhead))
+                score += shieldBonus[0];
+            else if (pawns.pawns[ui] & (1ULL << (oneAhead + forward)))
+                score += shieldBonus[1];
+            else
+                score += shieldBonus[2];
+        }
+    }
+
+    return score;
+}
+
+} // namespace
+
+
+int pieceValue(PieceType type) {
+    switch (type) {
+        case PieceType::PAWN:   return 100;
+        case PieceType::KNIGHT: return 320;
+        case PieceType::BISHOP: return 330;
+        case PieceType::ROOK:   return 500;
+        case PieceType::QUEEN:  return 900;
+        default:                return 0;
+    }
+}
+
+
+int evaluate(const Board& board, PawnTable& pawnTable) {
+    int score = 0;  // White's point of view
+
+    for (int square = 0; square < 64; ++square) {
+        Piece p = board.getPiece(square);
+        if (p.type == PieceType::NONE)
+            continue;
+
+        int value = pieceValue(p.type) + pieceSquareValue(p, square);
+        score += (p.color == Color::WHITE) ? value : -value;
+    }
+
+    const PawnEntry& pawns = probePawns(board, pawnTable);
+    score += pawns.score;
+    score += pawnsInPlay(board, Color::WHITE, pawns) - pawnsInPlay(board, Color::BLACK, pawns);
+
+    return (board.getSideToMove() == Color::WHITE) ? score : -score;
+}
+
+
+int evaluate(const Board& board) {
+    thread_local PawnTable pawns;
+    return evaluate(board, pawns);
+}
@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <iostream>
+#include "GameRecord.h"
+
+GameRecord::GameRecord(const Board& start, int interval)
+    : interval(std::max(1, interval)) {
+    reset(start);
+}
+
+
+void GameRecord::reset(const Board& start) {
+    moves.clear();
+    snapshots.assign(1, start);
+}
+
+
+void GameRecord::truncate(int ply) {
+    ply = std::max(0, std::min(ply, length()));
+    moves.resize(ply);
+
+    // Keep the snapshot at ply itself if it is exactly on the grid
+    snapshots.resize(ply / interval + 1);
+}
+
+
+void GameRecord::append(const Move& m, const Board& after) {
+    moves.push_back({static_cast<uint8_t>(m.from), static_cast<uint8_t>(m.to)});
+
+    if (length() % interval == 0)
+        snapshots.push_back(after);
+}
+
+
+Board GameRecord::positionAt(int ply) const {
+    ply = std::max(0, std::min(ply, length()));
+
+    int base = ply / interval;
+    Board board = snapshots[base];
+
+    for (int i = base * interval; i < ply; ++i) {
+        // Only the squares are stored; the board rebuilds the flags
+        Move m;
+        if (!board.lookupMove(moves[i].from, moves[i].to, m)) {
+            std::cerr << "Error: recorded move " << moveText(i)
+                      << " is not playable at ply " << i << std::endl;
+            break;
+        }
+        board.applyMove(m);
+    }
+
+    return board;
+}
+
+
+std::string GameRecord::moveText(int ply) const {
+    if (ply < 0 || ply >= length())
+        return "";
+
+    auto sqToStr = [](int sq) {
+        char file = 'a' + (sq % 8);
+        char rank = '1' + (sq / 8);
+        return std::string{file, rank};
+    };
+
+    return sqToStr(moves[ply].from) + sqToStr(moves[ply].to);
+}
@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "EndGamePopup.h"
+#include "GameScene.h"
+
+GameScene::GameScene(SceneStack& stack, sf::Vector2u windowSize, Opponent opponent)
+    : Scene(stack),
+      windowSize(windowSize),
+      tileSize(windowSize.y / 8.f),
+      opponent(opponent),
+      renderer(windowSize.y / 8.f),
+      // Right of the board: a thin eval bar, then the analysis lines
+      // above the move list
+      panel(sf::FloatRect({windowSize.y + 20.f, 170.f},
+                          {windowSize.x - windowSize.y - 20.f, windowSize.y - 170.f})),
+      analysisView(windowSize.y / 8.f,
+                   sf::FloatRect({static_cast<float>(windowSize.y), 0.f},
+                                 {20.f, static_cast<float>(windowSize.y)}),
+                   sf::FloatRect({windowSize.y + 20.f, 0.f},
+                                 {windowSize.x - windowSize.y - 20.f, 170.f}),
+                   opponent == Opponent::FRIEND) {
+
+    if (!renderer.loadTextures("images"))
+        throw std::runtime_error("Failed to build the piece atlas");
+
+    engineConfig.maxDepth = MAX_PLY;
+    engineConfig.moveTimeMs = 1000;
+}
+
+
+GameScene::~GameScene() {
+    // Cut the engine's search short rather than wait out its move time
+    // in the future's destructor
+    stopThinking = true;
+}
+
+
+void GameScene::handleEvent(const sf::Event& event) {
+    // Leaving works at any time; the destructor stops the engine
+    if (const auto* key = event.getIf<sf::Event::KeyPressed>()) {
+        if (key->code == sf::Keyboard::Key::Escape) {
+            stopThinking = true;
+            stack.pop();
+            return;
+        }
+    }
+
+    // The position is frozen while the engine is thinking
+    if (thinking.valid())
+        return;
+
+    // ---------- MOVE LIST ----------
+    int target = panel.handleEvent(event, game.getRecord(), game.getPly());
+    if (target != -1) {
+        seek(target);
+        return;
+    }
+
+    // ---------- UNDO / REDO ----------
+    if (const auto* key = event.getIf<sf::Event::KeyPressed>()) {
+        if (key->code == sf::Keyboard::Key::Left)
+            undoMove();
+        else if (key->code == sf::Keyboard::Key::Right)
+            redoMove();
+        else if (key->code == sf::Keyboard::Key::Home)
+            seek(0);
+        else if (key->code == sf::Keyboard::Key::End)
+            seek(game.getRecord().length());
+        else if (key->code == sf::Keyboard::Key::A && opponent == Opponent::FRIEND)
+            toggleAnalysis();
+        return;
+    }
+
+    // ---------- MOUSE INPUT ----------
+    if (const auto* mouse = event.getIf<sf::Event::MouseButtonPressed>()) {
+        if (mouse->button == sf::Mouse::Button::Left)
+            handleClick(mouse->position);
+    }
+}
+
+
+void GameScene::handleClick(sf::Vector2i position) {
+    int clickedSquare = pixelToSquare(position);
+    if (clickedSquare == -1 || engineToMove())
+        return;
+
+    Piece clickedPiece = game.getBoard().getPiece(clickedSquare);
+
+    // ---- SELECT ----
+    if (selectedSquare == -1) {
+        if (clickedPiece.type != PieceType::NONE &&
+            clickedPiece.color == game.getSideToMove()) {
+
+            selectedSquare = clickedSquare;
+            selectedMoves = game.legalMovesFrom(selectedSquare);
+        }
+        return;
+    }
+
+    // ---- MOVE ----
+    for (const auto& m : selectedMoves) {
+        if (m.to == clickedSquare) {
+            game.makeMove(m);
+            afterMove();
+            break;
+        }
+    }
+
+    clearSelection();
+}
+
+
+bool GameScene::update() {
+    using namespace std::chrono_literals;
+
+    bool redraw = changed;
+    changed = false;
+
+    if (analyzer)
+        redraw |= pollAnalysis();
+
+    if (thinking.valid()) {
+        if (thinking.wait_for(0ms) != std::future_status::ready)
+            return false;
+
+        // A stopped search belongs to a scene that is being left
+        SearchResult result = thinking.get();
+        if (result.hasMove && !stopThinking) {
+            game.makeMove(result.bestMove);
+            afterMove();
+        }
+        return true;
+    }
+
+    // Reviewing an earlier position never wakes the engine
+    if (engineToMove() && !game.isOver() && !game.canRedo()) {
+        // The worker gets its own copy of the position and search
+        Board position = game.getBoard();
+        SearchConfig config = engineConfig;
+        const std::atomic<bool>* stop = &stopThinking;
+        thinking = std::async(std::launch::async, [position, config, stop]() {
+            Search search(config);
+            search.setStopFlag(stop);
+            return search.think(position);
+        });
+    }
+
+    return redraw;
+}
+
+
+void GameScene::draw(sf::RenderTarget& target) {
+    target.clear();
+    renderer.update(game.getBoard(), selectedSquare, selectedMoves);
+    renderer.draw(target);
+    panel.draw(target, game.getRecord(), game.getPly());
+
+    // Results for an earlier position are not worth showing
+    bool current = analyzer && analysis.positionKey == game.getBoard().hashKey();
+    analysisView.draw(target, current ? &analysis : nullptr);
+}
+
+
+void GameScene::restart() {
+    game.reset();
+    clearSelection();
+}
+
+
+void GameScene::seek(int ply) {
+    game.seek(ply);
+    clearSelection();
+    changed = true;
+}
+
+
+void GameScene::undoMove() {
+    game.undoLastMove();
+
+    // Against the engine, step back to the human's turn
+    if (opponent == Opponent::COMPUTER && engineToMove())
+        game.undoLastMove();
+
+    clearSelection();
+}
+
+
+void GameScene::redoMove() {
+    game.redoLastMove();
+
+    if (opponent == Opponent::COMPUTER && engineToMove())
+        game.redoLastMove();
+
+    clearSelection();
+    afterMove();
+}
+
+
+void GameScene::afterMove() {
+    if (game.isOver())
+        stack.push(std::make_unique<EndGamePopup>(stack, *this, game.result(), windowSize));
+}
+
+
+void GameScene::toggleAnalysis() {
+    if (analyzer) {
+        analyzer.reset();
+        analysis = AnalysisInfo{};
+        changed = true;
+        return;
+    }
+
+    // Leave a core for the GUI thread
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    analyzer = std::make_unique<Analyzer>(threads, 3, 64, "analysis.tt");
+    analysedKey = 0;
+    changed = true;
+}
+
+
+// Follows the board and picks up new results. Polling is throttled to
+// every 100 ms: the scheduler wakes the loop at that rate while analysis
+// is on, and faster redraws would only flicker the lines.
+bool GameScene::pollAnalysis() {
+    using namespace std::chrono_literals;
+
+    uint64_t key = game.getBoard().hashKey();
+    if (key != analysedKey) {
+        analysedKey = key;
+        if (game.isOver())
+            analyzer->stop();
+        else
+            analyzer->start(game.getBoard());
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastPoll < 100ms)
+        return false;
+
+    lastPoll = now;
+    return analyzer->poll(analysis);
+}
+
+
+void GameScene::clearSelection() {
+    selectedSquare = -1;
+    selectedMoves.clear();
+}
+
+
+bool GameScene::engineToMove() const {
+    return opponent == Opponent::COMPUTER && game.getSideToMove() == engineColor;
+}
+
+
+int GameScene::pixelToSquare(sf::Vector2i pos) const {
+    if (pos.x < 0 || pos.y < 0) return -1;
+
+    int file = static_cast<int>(pos.x / tileSize);
+    int rank = 7 - static_cast<int>(pos.y / tileSize);
+
+    if (file < 0 || file > 7 || rank < 0 || rank > 7)
+        return -1;
+
+    return rank * 8 + file;
+}
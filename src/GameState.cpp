@@ -0,0 +1,81 @@
+#include <algorithm>
+#include "GameState.h"
+
+GameState::GameState() {
+    refresh();
+}
+
+GameState::GameState(const Board& board)
+    : board(board), record(board) {
+    refresh();
+}
+
+
+std::vector<Move> GameState::legalMovesFrom(int square) const {
+    std::vector<Move> result;
+    for (const auto& m : moves) {
+        if (m.from == square)
+            result.push_back(m);
+    }
+    return result;
+}
+
+
+void GameState::makeMove(const Move& m) {
+    Move move = m;
+
+    record.truncate(ply);
+    board.applyMove(move);
+    record.append(move, board);
+    ++ply;
+
+    refresh();
+}
+
+void GameState::undoLastMove() {
+    if (canUndo())
+        seek(ply - 1);
+}
+
+void GameState::redoLastMove() {
+    if (canRedo())
+        seek(ply + 1);
+}
+
+void GameState::seek(int target) {
+    target = std::max(0, std::min(target, record.length()));
+    if (target == ply)
+        return;
+
+    board = record.positionAt(target);
+    ply = target;
+    refresh();
+}
+
+void GameState::reset(const Board& start) {
+    board = start;
+    record.reset(start);
+    ply = 0;
+    refresh();
+}
+
+
+void GameState::refresh() {
+    Color side = board.getSideToMove();
+
+    // legalMoves builds the opponent's attack map, which kingInCheck reuses
+    moves = board.legalMoves(side);
+    check = board.kingInCheck(side);
+
+    // Mate and stalemate take precedence over the draw rules
+    if (moves.empty() && check)
+        gameResult = (side == Color::WHITE) ? GameResult::BLACK_WINS : GameResult::WHITE_WINS;
+    else if (moves.empty())
+        gameResult = GameResult::STALEMATE;
+    else if (board.repetitionCount() >= 2)
+        gameResult = GameResult::DRAW_REPETITION;
+    else if (board.isFiftyMoveDraw())
+        gameResult = GameResult::DRAW_FIFTY_MOVE;
+    else
+        gameResult = GameResult::ONGOING;
+}
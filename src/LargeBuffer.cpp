@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "LargeBuffer.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+constexpr size_t hugePageSize = 2 * 1024 * 1024;
+
+size_t roundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+#if defined(_WIN32)
+// Large pages need SeLockMemoryPrivilege. An account can hold it and still
+// have it disabled in the process token, so switch it on once here.
+// False when the account does not hold it at all.
+bool enableLockMemoryPrivilege() {
+    static const bool enabled = []() {
+        HANDLE token;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+            return false;
+
+        TOKEN_PRIVILEGES privileges{};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        bool ok = LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege",
+                                        &privileges.Privileges[0].Luid) &&
+                  AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                  GetLastError() == ERROR_SUCCESS;   // not ERROR_NOT_ALL_ASSIGNED
+        CloseHandle(token);
+        return ok;
+    }();
+    return enabled;
+}
+#endif
+
+} // namespace
+
+
+LargeBuffer::LargeBuffer(size_t size) : bytes(size) {
+    if (size == 0)
+        return;
+
+#if defined(_WIN32)
+    size_t largePage = GetLargePageMinimum();
+    if (largePage != 0 && enableLockMemoryPrivilege()) {
+        size_t length = roundUp(size, largePage);
+        base = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                            PAGE_READWRITE);
+        if (base) {
+            mapped = length;
+            pageSource = PageSource::LARGE_PAGES;
+        }
+    }
+    if (!base) {
+        base = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        mapped = size;
+    }
+    if (!base)
+        throw std::bad_alloc();
+    aligned = base;
+#else
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    // Only succeeds where the administrator reserved huge pages
+    if (size >= hugePageSize) {
+        size_t length = roundUp(size, hugePageSize);
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            base = aligned = p;
+            mapped = length;
+            pageSource = PageSource::HUGETLB;
+            return;
+        }
+    }
+#endif
+
+    // Over-allocate so the table can start on a 2 MB boundary; a
+    // transparent huge page can only back a whole aligned 2 MB range
+    size_t length = roundUp(size, hugePageSize) + hugePageSize;
+    void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        throw std::bad_alloc();
+
+    base = p;
+    mapped = length;
+    aligned = reinterpret_cast<void*>(roundUp(reinterpret_cast<uintptr_t>(p), hugePageSize));
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (size >= hugePageSize && madvise(aligned, roundUp(size, hugePageSize), MADV_HUGEPAGE) == 0)
+        pageSource = PageSource::TRANSPARENT;
+#endif
+#endif
+}
+
+
+LargeBuffer::~LargeBuffer() {
+    release();
+}
+
+
+LargeBuffer::LargeBuffer(LargeBuffer&& other) noexcept {
+    *this = std::move(other);
+}
+
+
+LargeBuffer& LargeBuffer::operator=(LargeBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        base = std::exchange(other.base, nullptr);
+        mapped = std::exchange(other.mapped, 0);
+        aligned = std::exchange(other.aligned, nullptr);
+        bytes = std::exchange(other.bytes, 0);
+        pageSource = std::exchange(other.pageSource, PageSource::NORMAL);
+    }
+    return *this;
+}
+
+
+void LargeBuffer::release() {
+    if (!base)
+        return;
+#if defined(_WIN32)
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, mapped);
+#endif
+    base = aligned = nullptr;
+    mapped = bytes = 0;
+}
+
+
+size_t LargeBuffer::hugeBytes() const {
+    switch (pageSource) {
+        case PageSource::HUGETLB:
+        case PageSource::LARGE_PAGES:
+            return bytes;
+        case PageSource::NORMAL:
+            return 0;
+        case PageSource::TRANSPARENT:
+            break;
+    }
+
+#if defined(__linux__)
+    // The kernel reports huge-page backing per mapping in smaps. madvise
+    // on the aligned range splits our mapping, so sum every mapping that
+    // overlaps the table rather than looking one up by address.
+    uintptr_t lo = reinterpret_cast<uintptr_t>(aligned);
+    uintptr_t hi = lo + roundUp(bytes, hugePageSize);
+
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool overlaps = false;
+    size_t total = 0;
+    while (std::getline(smaps, line)) {
+        // Mapping headers start "lo-hi perms ...", in hex
+        size_t dash = line.find('-');
+        bool header = dash != std::string::npos && dash > 0 &&
+            std::all_of(line.begin(), line.begin() + dash,
+                        [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); });
+        if (header) {
+            uintptr_t start = std::strtoull(line.c_str(), nullptr, 16);
+            uintptr_t end = std::strtoull(line.c_str() + dash + 1, nullptr, 16);
+            overlaps = start < hi && end > lo;
+            continue;
+        }
+        if (overlaps && line.compare(0, 14, "AnonHugePages:") == 0)
+            total += std::strtoull(line.c_str() + 14, nullptr, 10) * 1024;
+    }
+    return std::min(total, bytes);
+#endif
+    return 0;
+}
+
+
+std::string LargeBuffer::describe() const {
+    std::ostringstream out;
+    out << bytes / (1024 * 1024) << " MB, ";
+    switch (pageSource) {
+        case PageSource::HUGETLB:     out << "reserved huge pages"; break;
+        case PageSource::LARGE_PAGES: out << "large pages"; break;
+        case PageSource::TRANSPARENT: out << "transparent huge pages"; break;
+        case PageSource::NORMAL:      out << "normal pages"; break;
+    }
+    if (pageSource != PageSource::NORMAL)
+        out << " (" << hugeBytes() / (1024 * 1024) << " MB in 2 MB pages)";
+    return out.str();
+}
+
+
+void parallelChunks(size_t count, size_t minChunk,
+                    const std::function<void(size_t begin, size_t end)>& body) {
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    size_t threads = std::min(hardware, std::max<size_t>(1, count / std::max<size_t>(1, minChunk)));
+
+    if (threads == 1) {
+        body(0, count);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    size_t chunk = (count + threads - 1) / threads;
+    for (size_t begin = 0; begin < count; begin += chunk) {
+        size_t end = std::min(count, begin + chunk);
+        workers.emplace_back([&body, begin, end]() { body(begin, end); });
+    }
+    for (auto& worker : workers)
+        worker.join();
+}
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "Match.h"
+
+namespace {
+
+const char* START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+double expectedScore(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+} // namespace
+
+
+GameAdjudicator::GameAdjudicator(int maxPlies)
+    : maxPlies(maxPlies) {
+}
+
+
+bool GameAdjudicator::isOver(const GameState& game, GameOutcome& outcome) {
+    outcome = GameOutcome::DRAW;
+
+    switch (game.result()) {
+        case GameResult::WHITE_WINS:
+            outcome = GameOutcome::WHITE_WIN;
+            return true;
+        case GameResult::BLACK_WINS:
+            outcome = GameOutcome::BLACK_WIN;
+            return true;
+        case GameResult::ONGOING:
+            return plies >= maxPlies;
+        default:
+            return true;   // stalemate, repetition or fifty-move draw
+    }
+}
+
+
+void GameAdjudicator::recordMove() {
+    ++plies;
+}
+
+
+double MatchStats::score() const {
+    if (played() == 0)
+        return 0.5;
+    return (wins + 0.5 * draws) / played();
+}
+
+
+std::vector<std::string> loadOpenings(const std::string& path) {
+    std::vector<std::string> openings;
+
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Error: could not open opening book " << path << std::endl;
+        return openings;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::istringstream in(line);
+        std::string placement, side, castling, enPassant;
+        if (!(in >> placement) || placement[0] == '#')
+            continue;
+
+        std::string fen = placement;
+        Board board;
+        if (in >> side >> castling >> enPassant) {
+            fen += ' ' + side + ' ' + castling + ' ' + enPassant + " 0 1";
+            if (board.loadFen(fen)) {
+                openings.push_back(fen);
+                continue;
+            }
+        }
+        std::cerr << "Error: " << path << ":" << lineNumber
+                  << " is not a valid position, skipped" << std::endl;
+    }
+
+    return openings;
+}
+
+
+double eloFromScore(double score) {
+    if (score <= 0.0) return -1000.0;
+    if (score >= 1.0) return 1000.0;
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+
+// Normal approximation of the trinomial (win/draw/loss) log-likelihood ratio.
+double sprtLogLikelihoodRatio(const MatchStats& stats, double elo0, double elo1) {
+    int n = stats.played();
+    if (n == 0)
+        return 0.0;
+
+    double mean = stats.score();
+    double variance = (stats.wins   * (1.0 - mean) * (1.0 - mean)
+                     + stats.draws  * (0.5 - mean) * (0.5 - mean)
+                     + stats.losses * (0.0 - mean) * (0.0 - mean)) / n;
+    if (variance <= 0.0)
+        return 0.0;
+
+    double s0 = expectedScore(elo0);
+    double s1 = expectedScore(elo1);
+
+    return n * (s1 - s0) * (2.0 * mean - s0 - s1) / (2.0 * variance);
+}
+
+
+MatchRunner::MatchRunner(const MatchConfig& config)
+    : config(config) {
+    if (this->config.openings.empty())
+        this->config.openings.push_back(START_FEN);
+
+    // Parsed once here, so a game never has to make up a result for an
+    // opening it cannot set up
+    for (const auto& fen : this->config.openings) {
+        Board board;
+        if (board.loadFen(fen))
+            openings.push_back(board);
+        else
+            std::cerr << "Error: opening \"" << fen << "\" is not a valid position, skipped"
+                      << std::endl;
+    }
+
+    totalGames = (config.games + 1) / 2 * 2;
+}
+
+
+MatchStats MatchRunner::run() {
+    nextGame = 0;
+    stopRequested = false;
+    stats = MatchStats();
+
+    int threads = config.threads;
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    if (openings.empty()) {
+        std::cerr << "Error: no valid openings to play" << std::endl;
+        return stats;
+    }
+
+    std::cout << config.names[0] << " vs " << config.names[1] << ": "
+              << totalGames << " games on " << threads << " threads, "
+              << openings.size() << " openings\n";
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i)
+        pool.emplace_back(&MatchRunner::worker, this);
+    for (auto& t : pool)
+        t.join();
+
+    std::cout << "Final: " << stats.wins << " - " << stats.draws << " - " << stats.losses
+              << "  score " << stats.score()
+              << "  elo " << eloFromScore(stats.score()) << "\n";
+
+    return stats;
+}
+
+
+void MatchRunner::worker() {
+    // Searches are per thread and cleared before each game; nothing below
+    // touches shared state except the game counter and recordResult().
+    Search first(config.engines[0]);
+    Search second(config.engines[1]);
+
+    while (!stopRequested) {
+        int gameIndex = nextGame++;
+        if (gameIndex >= totalGames)
+            break;
+
+        // Both games of a pair use the same opening with colours swapped
+        const Board& opening = openings[(gameIndex / 2) % openings.size()];
+        bool firstIsWhite = (gameIndex % 2 == 0);
+
+        GameOutcome outcome = firstIsWhite
+            ? playGame(opening, first, second)
+            : playGame(opening, second, first);
+
+        recordResult(gameIndex, outcome);
+    }
+}
+
+
+GameOutcome MatchRunner::playGame(const Board& start, Search& white, Search& black) {
+    white.newGame();
+    black.newGame();
+
+    GameState game(start);
+    GameAdjudicator adjudicator(config.maxPlies);
+    GameOutcome outcome;
+
+    while (!adjudicator.isOver(game, outcome)) {
+        Search& engine = (game.getSideToMove() == Color::WHITE) ? white : black;
+        SearchResult result = engine.think(game.getBoard());
+        if (!result.hasMove)
+            return GameOutcome::DRAW;
+
+        adjudicator.recordMove();
+        game.makeMove(result.bestMove);
+    }
+
+    return outcome;
+}
+
+
+void MatchRunner::recordResult(int gameIndex, GameOutcome outcome) {
+    bool firstIsWhite = (gameIndex % 2 == 0);
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+
+    if (outcome == GameOutcome::DRAW)
+        ++stats.draws;
+    else if ((outcome == GameOutcome::WHITE_WIN) == firstIsWhite)
+        ++stats.wins;
+    else
+        ++stats.losses;
+
+    double llr = 0.0;
+    double lower = 0.0;
+    double upper = 0.0;
+    bool decided = false;
+
+    if (config.sprt.enabled) {
+        llr = sprtLogLikelihoodRatio(stats, config.sprt.elo0, config.sprt.elo1);
+        lower = std::log(config.sprt.beta / (1.0 - config.sprt.alpha));
+        upper = std::log((1.0 - config.sprt.beta) / config.sprt.alpha);
+        decided = llr <= lower || llr >= upper;
+    }
+
+    if (stats.played() % 10 == 0 || decided) {
+        std::cout << "Games " << stats.played() << ": "
+                  << stats.wins << " - " << stats.draws << " - " << stats.losses
+                  << "  score " << stats.score();
+        if (config.sprt.enabled)
+            std::cout << "  LLR " << llr << " [" << lower << ", " << upper << "]";
+        std::cout << std::endl;
+    }
+
+    if (decided && !stopRequested) {
+        std::cout << "SPRT: " << (llr >= upper ? "H1 accepted" : "H0 accepted")
+                  << " (elo0 " << config.sprt.elo0 << ", elo1 " << config.sprt.elo1 << ")"
+                  << std::endl;
+        stopRequested = true;
+    }
+}
@@ -0,0 +1,55 @@
+#include "Assets.h"
+#include "GameScene.h"
+#include "MenuScene.h"
+
+MenuScene::MenuScene(SceneStack& stack, sf::Vector2u windowSize)
+    : Scene(stack),
+      windowSize(windowSize),
+      title(Assets::instance().font("fonts/font.ttf"), "Chess", 72),
+      friendBtn({400.f, 80.f}),
+      computerBtn({400.f, 80.f}),
+      friendText(Assets::instance().font("fonts/font.ttf"), "Play vs Friend", 36),
+      computerText(Assets::instance().font("fonts/font.ttf"), "Play vs Computer", 36) {
+
+    float centerX = windowSize.x / 2.f;
+
+    title.setFillColor(sf::Color::Black);
+    title.setPosition({centerX - 100.f, 250.f});
+
+    friendBtn.setPosition({centerX - 200.f, 420.f});
+    friendBtn.setFillColor(sf::Color(200, 200, 200));
+
+    computerBtn.setPosition({centerX - 200.f, 540.f});
+    computerBtn.setFillColor(sf::Color(200, 200, 200));
+
+    friendText.setFillColor(sf::Color::Black);
+    friendText.setPosition(friendBtn.getPosition() + sf::Vector2f(75.f, 18.f));
+    computerText.setFillColor(sf::Color::Black);
+    computerText.setPosition(computerBtn.getPosition() + sf::Vector2f(50.f, 18.f));
+}
+
+
+void MenuScene::handleEvent(const sf::Event& event) {
+    const auto* mouse = event.getIf<sf::Event::MouseButtonPressed>();
+    if (!mouse || mouse->button != sf::Mouse::Button::Left)
+        return;
+
+    sf::Vector2f mp(mouse->position);
+
+    if (friendBtn.getGlobalBounds().contains(mp)) {
+        stack.push(std::make_unique<GameScene>(stack, windowSize, GameScene::Opponent::FRIEND));
+    }
+    else if (computerBtn.getGlobalBounds().contains(mp)) {
+        stack.push(std::make_unique<GameScene>(stack, windowSize, GameScene::Opponent::COMPUTER));
+    }
+}
+
+
+void MenuScene::draw(sf::RenderTarget& target) {
+    target.clear(sf::Color::White);
+    target.draw(title);
+    target.draw(friendBtn);
+    target.draw(computerBtn);
+    target.draw(friendText);
+    target.draw(computerText);
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <string>
+#include "Assets.h"
+#include "MoveListPanel.h"
+
+namespace {
+
+constexpr float ROW_HEIGHT = 30.f;
+constexpr float SLIDER_HEIGHT = 40.f;
+constexpr float PADDING = 12.f;
+
+} // namespace
+
+
+MoveListPanel::MoveListPanel(sf::FloatRect area)
+    : area(area) {
+
+    listArea = sf::FloatRect(
+        {area.position.x + PADDING, area.position.y + PADDING},
+        {area.size.x - 2 * PADDING, area.size.y - SLIDER_HEIGHT - 3 * PADDING});
+
+    sliderArea = sf::FloatRect(
+        {area.position.x + PADDING, area.position.y + area.size.y - SLIDER_HEIGHT - PADDING},
+        {area.size.x - 2 * PADDING, SLIDER_HEIGHT});
+}
+
+
+int MoveListPanel::visibleRows() const {
+    return std::max(1, static_cast<int>(listArea.size.y / ROW_HEIGHT));
+}
+
+
+// Scroll so the current move stays in view, one row above the bottom
+int MoveListPanel::firstVisibleRow(const GameRecord& record, int currentPly) const {
+    int rows = (record.length() + 1) / 2;
+    int currentRow = std::max(0, currentPly - 1) / 2;
+
+    int first = std::max(0, currentRow - visibleRows() + 2);
+    return std::min(first, std::max(0, rows - visibleRows()));
+}
+
+
+int MoveListPanel::plyAtSlider(float x, const GameRecord& record) const {
+    float t = (x - sliderArea.position.x) / sliderArea.size.x;
+    t = std::max(0.f, std::min(1.f, t));
+    return static_cast<int>(t * record.length() + 0.5f);
+}
+
+
+int MoveListPanel::handleEvent(const sf::Event& event, const GameRecord& record, int currentPly) {
+    if (const auto* mouse = event.getIf<sf::Event::MouseButtonPressed>()) {
+        if (mouse->button != sf::Mouse::Button::Left)
+            return -1;
+
+        sf::Vector2f mp(mouse->position);
+
+        if (sliderArea.contains(mp)) {
+            dragging = true;
+            return plyAtSlider(mp.x, record);
+        }
+
+        if (listArea.contains(mp)) {
+            // Left half of a row is White's move, right half Black's
+            int row = firstVisibleRow(record, currentPly) +
+                      static_cast<int>((mp.y - listArea.position.y) / ROW_HEIGHT);
+            int column = (mp.x - listArea.position.x) < listArea.size.x * 0.55f ? 0 : 1;
+            int ply = row * 2 + column + 1;
+
+            if (ply <= record.length())
+                return ply;
+        }
+        return -1;
+    }
+
+    if (const auto* moved = event.getIf<sf::Event::MouseMoved>()) {
+        if (dragging)
+            return plyAtSlider(static_cast<float>(moved->position.x), record);
+        return -1;
+    }
+
+    if (event.is<sf::Event::MouseButtonReleased>())
+        dragging = false;
+
+    return -1;
+}
+
+
+void MoveListPanel::draw(sf::RenderTarget& target, const GameRecord& record, int currentPly) const {
+    const sf::Font& font = Assets::instance().font("fonts/font.ttf");
+
+    sf::RectangleShape background(area.size);
+    background.setPosition(area.position);
+    background.setFillColor(sf::Color(40, 40, 40));
+    target.draw(background);
+
+    // --- Move list ---
+    int first = firstVisibleRow(record, currentPly);
+    int rows = (record.length() + 1) / 2;
+    float columnX = listArea.position.x + listArea.size.x * 0.55f;
+
+    for (int row = first; row < rows && row < first + visibleRows(); ++row) {
+        float y = listArea.position.y + (row - first) * ROW_HEIGHT;
+
+        for (int column = 0; column < 2; ++column) {
+            int ply = row * 2 + column;
+            if (ply >= record.length())
+                break;
+
+            float x = (column == 0) ? listArea.position.x + 48.f : columnX;
+
+            if (ply + 1 == currentPly) {
+                sf::RectangleShape highlight({listArea.size.x * 0.42f, ROW_HEIGHT});
+                highlight.setPosition({x - 6.f, y});
+                highlight.setFillColor(sf::Color(246, 246, 105, 120));
+                target.draw(highlight);
+            }
+
+            sf::Text text(font, record.moveText(ply), 20);
+            text.setPosition({x, y + 3.f});
+            target.draw(text);
+        }
+
+        sf::Text number(font, std::to_string(row + 1) + ".", 20);
+        number.setFillColor(sf::Color(160, 160, 160));
+        number.setPosition({listArea.position.x, y + 3.f});
+        target.draw(number);
+    }
+
+    // --- Slider ---
+    float trackY = sliderArea.position.y + sliderArea.size.y / 2.f;
+
+    sf::RectangleShape track({sliderArea.size.x, 4.f});
+    track.setPosition({sliderArea.position.x, trackY - 2.f});
+    track.setFillColor(sf::Color(120, 120, 120));
+    target.draw(track);
+
+    float t = record.length() ? static_cast<float>(currentPly) / record.length() : 1.f;
+
+    sf::RectangleShape knob({12.f, 28.f});
+    knob.setOrigin({6.f, 14.f});
+    knob.setPosition({sliderArea.position.x + t * sliderArea.size.x, trackY});
+    knob.setFillColor(sf::Color(220, 220, 220));
+    target.draw(knob);
+}
@@ -0,0 +1,119 @@
+#include <utility>
+#include "Evaluation.h"
+#include "MovePicker.h"
+
+int mvvLva(const Board& board, const Move& m) {
+    int score = 0;
+    if (m.captured.type != PieceType::NONE) {
+        score += 10 * pieceValue(m.captured.type)
+               - pieceValue(board.getPiece(m.from).type);
+        score += 100000;
+    }
+    if (m.promotion)
+        score += 90000;
+    return score;
+}
+
+
+MovePicker::MovePicker(const Board& board, const Move* hash, SearchFrame& frame,
+                       Arena& arena, bool capturesOnly)
+    : board(board), capturesOnly(capturesOnly),
+      frame(frame), moves(frame.moves), scratch(arena), arena(arena) {
+
+    // The table only stores squares; rebuild the move and make sure it
+    // is still playable here (hash collisions, different castling rights)
+    if (hash && board.lookupMove(hash->from, hash->to, hashMove)) {
+        hasHashMove = !capturesOnly ||
+                      hashMove.captured.type != PieceType::NONE ||
+                      hashMove.promotion;
+    }
+}
+
+
+bool MovePicker::next(Move& move) {
+    while (true) {
+        switch (stage) {
+            case Stage::HASH_MOVE:
+                stage = Stage::GENERATE_CAPTURES;
+                if (hasHashMove) {
+                    move = hashMove;
+                    return true;
+                }
+                break;
+
+            case Stage::GENERATE_CAPTURES:
+                moves.clear();
+                board.generateMoves(GenType::CAPTURES, moves);
+                scores = arena.allocate<int>(moves.size());
+                for (size_t i = 0; i < moves.size(); ++i)
+                    scores[i] = mvvLva(board, moves[i]);
+                index = 0;
+                stage = Stage::CAPTURES;
+                break;
+
+            case Stage::CAPTURES:
+                while (index < moves.size()) {
+                    // Selection sort one step at a time: a cutoff on the
+                    // first capture never pays for sorting the rest
+                    size_t best = index;
+                    for (size_t i = index + 1; i < moves.size(); ++i) {
+                        if (scores[i] > scores[best])
+                            best = i;
+                    }
+                    std::swap(moves[index], moves[best]);
+                    std::swap(scores[index], scores[best]);
+
+                    const Move& m = moves[index++];
+                    if (!isHashMove(m)) {
+                        move = m;
+                        return true;
+                    }
+                }
+                stage = capturesOnly ? Stage::DONE : Stage::KILLERS;
+                index = 0;
+                break;
+
+            case Stage::KILLERS:
+                while (index < static_cast<size_t>(frame.killerCount)) {
+                    const Move& killer = frame.killers[index++];
+
+                    // Killers come from sibling positions; only a quiet
+                    // move that is playable here counts
+                    Move m;
+                    if (board.lookupMove(killer.from, killer.to, m) && isQuiet(m) &&
+                        !isHashMove(m)) {
+                        move = m;
+                        return true;
+                    }
+                }
+                stage = Stage::GENERATE_QUIETS;
+                break;
+
+            case Stage::GENERATE_QUIETS:
+                moves.clear();
+                board.generateMoves(GenType::QUIETS, moves);
+                index = 0;
+                stage = Stage::QUIETS;
+                break;
+
+            case Stage::QUIETS:
+                while (index < moves.size()) {
+                    const Move& m = moves[index++];
+                    if (!isHashMove(m) && !frame.isKiller(m)) {
+                        move = m;
+                        return true;
+                    }
+                }
+                stage = Stage::DONE;
+                break;
+
+            case Stage::DONE:
+                return false;
+        }
+    }
+}
+
+
+bool MovePicker::isHashMove(const Move& m) const {
+    return hasHashMove && m.from == hashMove.from && m.to == hashMove.to;
+}
@@ -0,0 +1,16 @@
+#include "PawnTable.h"
+#include "LargeBuffer.h"
+
+PawnTable::PawnTable(size_t entries) {
+    size_t count = floorPowerOfTwo(entries);
+    this->entries.resize(count);
+    mask = count - 1;
+}
+
+
+void PawnTable::clear() {
+    for (auto& entry : entries)
+        entry = PawnEntry{};
+    hits = 0;
+    misses = 0;
+}
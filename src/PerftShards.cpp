@@ -0,0 +1,269 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include "PerftShards.h"
+
+#if defined(_WIN32)
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace {
+
+// Journal layout, one record per line:
+//   # chess_perft journal
+//   fen <fen>
+//   depth <n>
+//   split <n>
+//   <path>\t<nodes>          for each finished job
+// A line is only trusted once its newline is on disk; a run killed
+// mid-write leaves a partial last line that is ignored and rerun.
+const char* const journalTitle = "# chess_perft journal";
+
+std::string firstMove(const std::string& path) {
+    return path.substr(0, path.find(' '));
+}
+
+} // namespace
+
+
+ShardedPerft::ShardedPerft(const PerftShardConfig& config) : config(config) {
+}
+
+
+bool ShardedPerft::run() {
+    Board board;
+    if (!config.fen.empty() && !board.loadFen(config.fen))
+        return false;
+    config.fen = board.toFen();
+
+    if (config.splitPly < 1 || config.splitPly >= config.depth) {
+        std::cerr << "Error: split ply must be between 1 and depth - 1" << std::endl;
+        return false;
+    }
+    if (config.workers.empty()) {
+        std::cerr << "Error: no worker commands" << std::endl;
+        return false;
+    }
+
+    jobs.clear();
+    rootMoves.clear();
+    enumerate(board, 0, "");
+
+    std::ofstream journal;
+    if (!config.journal.empty()) {
+        if (!readJournal())
+            return false;
+
+        bool fresh = !std::ifstream(config.journal).good();
+        journal.open(config.journal, std::ios::app);
+        if (!journal) {
+            std::cerr << "Error: cannot write " << config.journal << std::endl;
+            return false;
+        }
+        if (fresh) {
+            journal << journalTitle << "\n"
+                    << "fen " << config.fen << "\n"
+                    << "depth " << config.depth << "\n"
+                    << "split " << config.splitPly << "\n" << std::flush;
+        }
+        journalOut = &journal;
+    }
+
+    size_t done = 0;
+    for (const auto& job : jobs)
+        done += job.done;
+    finished = done;
+    std::cout << jobs.size() << " subtrees at ply " << config.splitPly << ", "
+              << done << " already in the journal, " << config.workers.size()
+              << " workers" << std::endl;
+
+    nextJob = 0;
+    std::vector<std::thread> threads;
+    for (const auto& command : config.workers)
+        threads.emplace_back(&ShardedPerft::worker, this, command);
+    for (auto& thread : threads)
+        thread.join();
+
+    journalOut = nullptr;
+
+    for (const auto& job : jobs) {
+        if (!job.done) {
+            std::cerr << "Error: " << (jobs.size() - finished) << " subtrees unfinished;"
+                      << " rerun with the same journal to resume" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void ShardedPerft::enumerate(Board& board, int ply, const std::string& path) {
+    if (ply == config.splitPly) {
+        jobs.push_back({path, board.toFen()});
+        return;
+    }
+
+    for (auto move : board.legalMoves(board.getSideToMove())) {
+        std::string name = board.moveToString(move);
+        if (ply == 0)
+            rootMoves.push_back(name);
+
+        board.applyMove(move);
+        enumerate(board, ply + 1, path.empty() ? name : path + " " + name);
+        board.undoMove(move);
+    }
+}
+
+
+bool ShardedPerft::readJournal() {
+    std::ifstream in(config.journal);
+    if (!in)
+        return true;   // nothing done yet
+
+    std::map<std::string, Job*> byPath;
+    for (auto& job : jobs)
+        byPath[job.path] = &job;
+
+    std::string expected[] = {
+        journalTitle,
+        "fen " + config.fen,
+        "depth " + std::to_string(config.depth),
+        "split " + std::to_string(config.splitPly),
+    };
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        bool complete = !in.eof();
+
+        if (lineNumber < 4) {
+            if (!complete || line != expected[lineNumber]) {
+                std::cerr << "Error: " << config.journal
+                          << " belongs to a different run (" << line << ")" << std::endl;
+                return false;
+            }
+            ++lineNumber;
+            continue;
+        }
+
+        size_t tab = line.find('\t');
+        if (!complete || tab == std::string::npos)
+            continue;
+
+        const char* digits = line.c_str() + tab + 1;
+        char* end = nullptr;
+        uint64_t nodes = std::strtoull(digits, &end, 10);
+        if (end == digits || *end != '\0')
+            continue;
+
+        auto it = byPath.find(line.substr(0, tab));
+        if (it != byPath.end()) {
+            it->second->nodes = nodes;
+            it->second->done = true;
+        }
+    }
+
+    // Appending after a torn line would glue the next record onto it
+    std::ifstream tail(config.journal, std::ios::binary | std::ios::ate);
+    if (tail.tellg() > 0) {
+        tail.seekg(-1, std::ios::end);
+        if (tail.get() != '\n')
+            std::ofstream(config.journal, std::ios::app) << "\n";
+    }
+    return true;
+}
+
+
+void ShardedPerft::worker(const std::string& command) {
+    while (true) {
+        size_t index = nextJob++;
+        if (index >= jobs.size())
+            return;
+
+        Job& job = jobs[index];
+        if (job.done)
+            continue;
+
+        uint64_t nodes = 0;
+        if (runJob(command, job, nodes)) {
+            record(job, nodes);
+        } else {
+            // Leave this worker's job for a rerun rather than retry on
+            // what may be a dead machine; the other workers carry on
+            std::lock_guard<std::mutex> lock(mutex);
+            std::cerr << "Error: worker \"" << command << "\" failed on " << job.path
+                      << "; it takes no more jobs" << std::endl;
+            return;
+        }
+    }
+}
+
+
+bool ShardedPerft::runJob(const std::string& command, const Job& job, uint64_t& nodes) const {
+    // FENs never contain double quotes, so quoting the FEN in them is safe
+    std::string line = command + " --depth " + std::to_string(config.depth - config.splitPly) +
+                       " --fen \"" + job.fen + "\"";
+#if defined(_WIN32)
+    // _popen runs "cmd /c line". With more than two quotes, or a leading
+    // one, cmd strips the first and last quote of the line, so give it an
+    // outer pair to strip.
+    line = "\"" + line + "\"";
+#endif
+
+    FILE* pipe = popen(line.c_str(), "r");
+    if (!pipe)
+        return false;
+
+    std::string output;
+    char buffer[256];
+    while (std::fgets(buffer, sizeof(buffer), pipe))
+        output += buffer;
+
+    if (pclose(pipe) != 0)
+        return false;
+
+    size_t at = output.find("Nodes: ");
+    if (at == std::string::npos)
+        return false;
+
+    nodes = std::strtoull(output.c_str() + at + 7, nullptr, 10);
+    return true;
+}
+
+
+void ShardedPerft::record(Job& job, uint64_t nodes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    job.nodes = nodes;
+    job.done = true;
+
+    if (journalOut)
+        *journalOut << job.path << "\t" << nodes << "\n" << std::flush;
+
+    size_t count = ++finished;
+    std::cout << "[" << count << "/" << jobs.size() << "] " << job.path
+              << ": " << nodes << std::endl;
+}
+
+
+uint64_t ShardedPerft::total() const {
+    uint64_t sum = 0;
+    for (const auto& job : jobs)
+        sum += job.nodes;
+    return sum;
+}
+
+
+void ShardedPerft::printDivide(std::ostream& out) const {
+    std::map<std::string, uint64_t> perMove;
+    for (const auto& job : jobs)
+        perMove[firstMove(job.path)] += job.nodes;
+
+    for (const auto& move : rootMoves)
+        out << move << ": " << perMove[move] << "\n";
+    out << "Total: " << total() << std::endl;
+}
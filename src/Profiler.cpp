@@ -0,0 +1,109 @@
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include "Profiler.h"
+
+namespace profile {
+
+namespace {
+
+// Slots outlive their threads so counts from finished workers still
+// show up in the report
+std::mutex registryMutex;
+std::vector<std::unique_ptr<Counters>> registry;
+
+} // namespace
+
+#ifdef CHESS_PROFILE
+
+thread_local Counters* localCounters = nullptr;
+
+Counters* registerThread() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.push_back(std::make_unique<Counters>());
+    return registry.back().get();
+}
+
+#endif
+
+
+const char* name(ProfilePoint point) {
+    switch (point) {
+        case ProfilePoint::PSEUDO_LEGAL_MOVES: return "pseudoLegalMoves";
+        case ProfilePoint::ADD_PAWN_MOVES:     return "addPawnMoves";
+        case ProfilePoint::ADD_KNIGHT_MOVES:   return "addKnightMoves";
+        case ProfilePoint::ADD_BISHOP_MOVES:   return "addBishopMoves";
+        case ProfilePoint::ADD_ROOK_MOVES:     return "addRookMoves";
+        case ProfilePoint::ADD_QUEEN_MOVES:    return "addQueenMoves";
+        case ProfilePoint::ADD_KING_MOVES:     return "addKingMoves";
+        case ProfilePoint::SQUARE_ATTACKED:    return "squareAttacked";
+        case ProfilePoint::KING_IN_CHECK:      return "kingInCheck";
+        case ProfilePoint::APPLY_MOVE:         return "applyMove";
+        case ProfilePoint::UNDO_MOVE:          return "undoMove";
+        case ProfilePoint::LEGAL_FILTER:       return "legalFilter";
+        case ProfilePoint::COUNT_LEGAL_MOVES:  return "countLegalMoves";
+        default:                               return "?";
+    }
+}
+
+
+Counters totals() {
+    Counters sum{};
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& counters : registry) {
+        for (size_t i = 0; i < sum.size(); ++i) {
+            sum[i].calls += (*counters)[i].calls;
+            sum[i].cycles += (*counters)[i].cycles;
+        }
+    }
+    return sum;
+}
+
+
+void reset() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto& counters : registry)
+        counters->fill(Counter{});
+}
+
+
+void printReport(std::ostream& out) {
+    if (!enabled()) {
+        out << "Profiling disabled (configure with -DCHESS_PROFILE=ON)\n";
+        return;
+    }
+
+    Counters sum = totals();
+
+    out << std::left << std::setw(20) << "point"
+        << std::right << std::setw(14) << "calls"
+        << std::setw(18) << "cycles"
+        << std::setw(12) << "cyc/call" << "\n";
+
+    for (size_t i = 0; i < sum.size(); ++i) {
+        const Counter& c = sum[i];
+        out << std::left << std::setw(20) << name(static_cast<ProfilePoint>(i))
+            << std::right << std::setw(14) << c.calls
+            << std::setw(18) << c.cycles
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << (c.calls ? static_cast<double>(c.cycles) / c.calls : 0.0) << "\n";
+    }
+}
+
+
+void writeJson(std::ostream& out) {
+    Counters sum = totals();
+
+    out << "{\n  \"enabled\": " << (enabled() ? "true" : "false") << ",\n  \"points\": {";
+    for (size_t i = 0; i < sum.size(); ++i) {
+        out << (i ? ",\n" : "\n")
+            << "    \"" << name(static_cast<ProfilePoint>(i)) << "\": { \"calls\": "
+            << sum[i].calls << ", \"cycles\": " << sum[i].cycles << " }";
+    }
+    out << "\n  }\n}\n";
+}
+
+} // namespace profile
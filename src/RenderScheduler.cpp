@@ -0,0 +1,35 @@
+#include "RenderScheduler.h"
+
+RenderScheduler::RenderScheduler(sf::RenderWindow& window, unsigned maxFramerate)
+    : window(window) {
+    window.setFramerateLimit(maxFramerate);
+}
+
+
+std::optional<sf::Event> RenderScheduler::nextEvent() {
+    std::optional<sf::Event> event;
+
+    if (!draining && !dirty && !animating) {
+        // idle: sleep until something happens (sf::Time::Zero waits forever)
+        event = window.waitEvent(sf::milliseconds(wakeIntervalMs));
+    } else {
+        event = window.pollEvent();
+    }
+
+    draining = event.has_value();
+
+    // Pointer motion alone changes nothing on screen
+    if (event && !event->is<sf::Event::MouseMoved>())
+        dirty = true;
+
+    return event;
+}
+
+
+bool RenderScheduler::beginFrame() {
+    if (!dirty && !animating)
+        return false;
+
+    dirty = false;
+    return true;
+}
@@ -0,0 +1,88 @@
+#include "Scene.h"
+
+void SceneStack::push(std::unique_ptr<Scene> scene) {
+    pending.push_back({Change::Kind::PUSH, std::move(scene)});
+}
+
+void SceneStack::pop() {
+    pending.push_back({Change::Kind::POP, nullptr});
+}
+
+void SceneStack::clear() {
+    pending.push_back({Change::Kind::CLEAR, nullptr});
+}
+
+
+void SceneStack::applyPending() {
+    // Move the queue out first: destructors may not touch it, but pushes
+    // made by constructors of new scenes must not be lost
+    auto changes = std::move(pending);
+    pending.clear();
+
+    for (auto& change : changes) {
+        switch (change.kind) {
+            case Change::Kind::PUSH:
+                scenes.push_back(std::move(change.scene));
+                break;
+            case Change::Kind::POP:
+                if (!scenes.empty())
+                    scenes.pop_back();
+                break;
+            case Change::Kind::CLEAR:
+                scenes.clear();
+                break;
+        }
+    }
+}
+
+
+void SceneStack::handleEvent(const sf::Event& event) {
+    if (!scenes.empty())
+        scenes.back()->handleEvent(event);
+    applyPending();
+}
+
+
+bool SceneStack::update() {
+    bool changed = false;
+    for (auto& scene : scenes)
+        changed |= scene->update();
+
+    bool stackChanged = !pending.empty();
+    applyPending();
+    return changed || stackChanged;
+}
+
+
+void SceneStack::draw(sf::RenderTarget& target) {
+    if (scenes.empty())
+        return;
+
+    // Start from the topmost opaque scene
+    size_t first = scenes.size() - 1;
+    while (first > 0 && scenes[first]->isOverlay())
+        --first;
+
+    for (size_t i = first; i < scenes.size(); ++i)
+        scenes[i]->draw(target);
+}
+
+
+bool SceneStack::isAnimating() const {
+    for (const auto& scene : scenes) {
+        if (scene->isAnimating())
+            return true;
+    }
+    return false;
+}
+
+
+int SceneStack::wakeIntervalMs() const {
+    int interval = 0;
+    for (const auto& scene : scenes) {
+        int ms = scene->wakeIntervalMs();
+        if (ms > 0 && (interval == 0 || ms < interval))
+            interval = ms;
+    }
+    return interval;
+}
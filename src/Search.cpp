@@ -0,0 +1,494 @@
+#include <algorithm>
+#include <cstdlib>
+#include "Search.h"
+#include "Evaluation.h"
+#include "MovePicker.h"
+
+namespace {
+
+// Mate scores are stored relative to the node, not the root
+int scoreToTT(int score, int ply) {
+    if (score >= MATE_SCORE - MAX_PLY) return score + ply;
+    if (score <= -MATE_SCORE + MAX_PLY) return score - ply;
+    return score;
+}
+
+int scoreFromTT(int score, int ply) {
+    if (score >= MATE_SCORE - MAX_PLY) return score - ply;
+    if (score <= -MATE_SCORE + MAX_PLY) return score + ply;
+    return score;
+}
+
+// Null-move pruning is unsound in zugzwang, which in practice means
+// king and pawn endings
+bool hasPieces(const Board& board, Color side) {
+    for (int square = 0; square < 64; ++square) {
+        Piece p = board.getPiece(square);
+        if (p.color == side && p.type != PieceType::NONE &&
+            p.type != PieceType::PAWN && p.type != PieceType::KING)
+            return true;
+    }
+    return false;
+}
+
+// Largest positional swing a quiet move is trusted to make, by depth
+constexpr int futilityMargin[3] = {0, 150, 300};
+
+} // namespace
+
+
+bool disableSearchFeature(SearchConfig& config, const std::string& name) {
+    if (name == "aspiration")    config.aspiration = false;
+    else if (name == "pvs")      config.pvs = false;
+    else if (name == "nullmove") config.nullMove = false;
+    else if (name == "lmr")      config.lmr = false;
+    else if (name == "futility") config.futility = false;
+    else return false;
+    return true;
+}
+
+
+Search::Search(const SearchConfig& config, std::shared_ptr<TranspositionTable> table)
+    : config(config), tt(std::move(table)) {
+    if (!tt)
+        tt = std::make_shared<TranspositionTable>(config.hashMb);
+}
+
+
+void Search::newGame() {
+    tt->clear();
+    pawnTable.clear();
+    context.reset();
+}
+
+
+SearchResult Search::think(const Board& position) {
+    Board board = position;
+    SearchResult result;
+
+    counters = SearchCounters{};
+    stopped = false;
+    startTime = std::chrono::steady_clock::now();
+
+    context.reset();
+    board.reserveHistory(MAX_PLY);
+
+    auto rootMoves = board.legalMoves(board.getSideToMove());
+    if (rootMoves.empty())
+        return result;
+
+    orderMoves(board, rootMoves);
+    result.bestMove = rootMoves.front();
+    result.hasMove = true;
+
+    size_t lineCount = std::min<size_t>(std::max(1, config.multiPv), rootMoves.size());
+
+    for (int depth = 1; depth <= config.maxDepth; ++depth) {
+        SearchCounters before = counters;
+        double iterationStart = elapsedMs();
+
+        // --- Aspiration window ---
+        // Scores rarely move far between iterations, and a narrow window
+        // cuts more. A result outside it is searched again, the failing
+        // side widened each time. Multi-PV needs exact scores for every
+        // line, so it always searches the full window.
+        int delta = config.aspirationWindow;
+        int alpha = -INFINITE_SCORE;
+        int beta = INFINITE_SCORE;
+        bool mateScore = std::abs(result.score) >= MATE_SCORE - MAX_PLY;
+
+        if (config.aspiration && lineCount == 1 && depth >= 4 && !mateScore) {
+            alpha = result.score - delta;
+            beta = result.score + delta;
+        }
+
+        std::vector<SearchLine> top;
+
+        while (true) {
+            searchRoot(board, rootMoves, depth, alpha, beta, lineCount, top);
+            if (stopped)
+                break;
+
+            bool failLow = top.empty();
+            bool failHigh = !failLow && top.front().score >= beta;
+            if (!failLow && !failHigh)
+                break;
+
+            ++counters.aspirationResearches;
+            delta *= 2;
+            if (failLow)
+                alpha = std::max(-INFINITE_SCORE, alpha - delta);
+            else
+                beta = std::min(INFINITE_SCORE, beta + delta);
+        }
+
+        // A partially searched iteration is thrown away
+        if (stopped)
+            break;
+
+        result.bestMove = top.front().pv.front();
+        result.score = top.front().score;
+        result.depth = depth;
+        result.nodes = counters.nodes;
+
+        IterationStats iteration;
+        iteration.depth = depth;
+        iteration.score = result.score;
+        iteration.timeMs = elapsedMs();
+        iteration.iterationMs = iteration.timeMs - iterationStart;
+        iteration.counters = counters.since(before);
+        if (!result.stats.iterations.empty() && result.stats.iterations.back().counters.nodes)
+            iteration.branchingFactor = static_cast<double>(iteration.counters.nodes) /
+                                        result.stats.iterations.back().counters.nodes;
+        result.stats.iterations.push_back(iteration);
+        result.stats.total = counters;
+        result.stats.timeMs = iteration.timeMs;
+
+        for (auto& line : top)
+            extendPv(board, line.pv, depth);
+        result.lines = top;
+
+        // --- Search this iteration's best lines first next time ---
+        for (size_t i = top.size(); i-- > 0; ) {
+            const Move& first = top[i].pv.front();
+            auto it = std::find_if(rootMoves.begin(), rootMoves.end(),
+                [&](const Move& m) {
+                    return m.from == first.from && m.to == first.to;
+                });
+            std::rotate(rootMoves.begin(), it, it + 1);
+        }
+
+        if (onIteration)
+            onIteration(result);
+
+        int best = result.score;
+        if (best >= MATE_SCORE - MAX_PLY || best <= -MATE_SCORE + MAX_PLY)
+            break;
+    }
+
+    result.nodes = counters.nodes;
+    result.stats.total = counters;
+    result.stats.timeMs = elapsedMs();
+    return result;
+}
+
+
+// Searches every root move inside (alpha, beta) and leaves the best
+// lines in top, highest score first. A move only gets an exact score if
+// it beats the weakest line kept so far; with PVS that is first tried
+// with a zero window. Stops early on a fail high.
+void Search::searchRoot(Board& board, const std::vector<Move>& rootMoves, int depth,
+                        int alpha, int beta, size_t lineCount, std::vector<SearchLine>& top) {
+    top.clear();
+
+    for (auto move : rootMoves) {
+        int floor = (top.size() == lineCount) ? top.back().score : alpha;
+
+        board.applyMove(move);
+        int score;
+        if (config.pvs && top.size() == lineCount) {
+            score = -negamax(board, depth - 1, -floor - 1, -floor, 1);
+            if (score > floor && score < beta && !stopped) {
+                ++counters.pvsResearches;
+                score = -negamax(board, depth - 1, -beta, -floor, 1);
+            }
+        } else {
+            score = -negamax(board, depth - 1, -beta, -floor, 1);
+        }
+        board.undoMove(move);
+
+        if (stopped)
+            break;
+
+        if (score > floor) {
+            context.updatePv(0, move);
+            const SearchFrame& root = context.frame(0);
+
+            auto pos = std::find_if(top.begin(), top.end(),
+                [&](const SearchLine& line) { return score > line.score; });
+            top.insert(pos, {score, std::vector<Move>(root.pv.begin(),
+                                                      root.pv.begin() + root.pvLength)});
+            if (top.size() > lineCount)
+                top.pop_back();
+
+            if (score >= beta)
+                break;
+        }
+    }
+}
+
+
+int Search::negamax(Board& board, int depth, int alpha, int beta, int ply, bool allowNull) {
+    SearchFrame& frame = context.frame(ply);
+    frame.pvLength = 0;
+
+    if (depth <= 0) {
+        return config.quiescence ? quiescence(board, alpha, beta, ply)
+                                 : evaluate(board, pawnTable);
+    }
+
+    ++counters.nodes;
+    counters.selDepth = std::max(counters.selDepth, ply);
+    if (shouldStop())
+        return 0;
+
+    // A single repetition inside the tree is scored as the draw it can force
+    if (board.repetitionCount() >= 1 || board.isFiftyMoveDraw())
+        return 0;
+
+    if (ply >= MAX_PLY)
+        return evaluate(board, pawnTable);
+
+    // --- Transposition table ---
+    uint64_t key = board.hashKey();
+    TTEntry entry;
+    Move ttMove{};
+    bool haveTTMove = false;
+
+    bool collision = false;
+    ++counters.ttProbes;
+
+    if (tt->probe(key, entry, collision)) {
+        ++counters.ttHits;
+        if (entry.depth >= depth) {
+            int ttScore = scoreFromTT(entry.score, ply);
+            if (entry.bound == Bound::EXACT ||
+                (entry.bound == Bound::LOWER && ttScore >= beta) ||
+                (entry.bound == Bound::UPPER && ttScore <= alpha)) {
+                ++counters.ttCutoffs;
+                return std::max(alpha, std::min(beta, ttScore));
+            }
+        }
+        if (entry.hasMove()) {
+            ttMove.from = entry.from;
+            ttMove.to = entry.to;
+            haveTTMove = true;
+        }
+    } else if (collision) {
+        ++counters.ttCollisions;
+    }
+
+    Color side = board.getSideToMove();
+    Color them = (side == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    bool inCheck = board.kingInCheck(side);
+    bool pvNode = beta - alpha > 1;
+
+    // Pruning is left to zero-window nodes out of check and away from mates
+    bool prunable = !pvNode && !inCheck && std::abs(beta) < MATE_SCORE - MAX_PLY;
+    if (prunable && (config.nullMove || config.futility))
+        frame.staticEval = evaluate(board, pawnTable);
+
+    // --- Null move ---
+    // If passing the turn still fails high, some real move will as well
+    if (config.nullMove && allowNull && prunable && depth >= 3 &&
+        frame.staticEval >= beta && hasPieces(board, side)) {
+        int reduction = depth >= 6 ? 3 : 2;
+        ++counters.nullMoveTries;
+
+        board.makeNullMove(frame.move);
+        int score = -negamax(board, depth - 1 - reduction, -beta, -beta + 1, ply + 1, false);
+        board.undoNullMove(frame.move);
+
+        if (stopped)
+            return 0;
+        if (score >= beta) {
+            ++counters.nullMoveCutoffs;
+            return beta;
+        }
+    }
+
+    // --- Futility ---
+    // Next to the horizon a quiet move far below alpha stays there
+    bool futile = config.futility && prunable && depth <= 2 &&
+                  frame.staticEval + futilityMargin[depth] <= alpha;
+
+    int originalAlpha = alpha;
+    int legalCount = 0;
+    Move bestMove{};
+    bool haveBest = false;
+
+    MovePicker picker(board, haveTTMove ? &ttMove : nullptr, frame, context.arena);
+    Move& move = frame.move;
+
+    while (picker.next(move)) {
+        board.applyMove(move);
+        if (board.kingInCheck(side)) {
+            board.undoMove(move);
+            continue;
+        }
+        ++legalCount;
+
+        bool quiet = isQuiet(move);
+        bool lateQuiet = quiet && depth >= 3 && legalCount > 3 && !inCheck;
+        bool givesCheck = quiet && (futile || (config.lmr && lateQuiet)) &&
+                          board.kingInCheck(them);
+
+        if (futile && quiet && legalCount > 1 && !givesCheck) {
+            board.undoMove(move);
+            ++counters.futilityPrunes;
+            continue;
+        }
+
+        // --- Principal variation search ---
+        // The first move gets the full window; the rest only have to be
+        // shown no better, with a zero window and late quiet moves
+        // reduced. Whatever beats alpha anyway is searched again.
+        int score;
+        if (legalCount == 1) {
+            score = -negamax(board, depth - 1, -beta, -alpha, ply + 1);
+        } else {
+            int reduction = 0;
+            if (config.lmr && lateQuiet && !givesCheck && !frame.isKiller(move)) {
+                reduction = (legalCount > 8 && !pvNode) ? 2 : 1;
+                reduction = std::min(reduction, depth - 2);
+                ++counters.lmrReductions;
+            }
+
+            int searchBeta = config.pvs ? alpha + 1 : beta;
+            score = -negamax(board, depth - 1 - reduction, -searchBeta, -alpha, ply + 1);
+
+            if (reduction > 0 && score > alpha && !stopped) {
+                ++counters.lmrResearches;
+                score = -negamax(board, depth - 1, -searchBeta, -alpha, ply + 1);
+            }
+            if (config.pvs && score > alpha && score < beta && !stopped) {
+                ++counters.pvsResearches;
+                score = -negamax(board, depth - 1, -beta, -alpha, ply + 1);
+            }
+        }
+        board.undoMove(move);
+
+        if (stopped)
+            return 0;
+
+        if (score >= beta) {
+            ++counters.betaCutoffs;
+            if (legalCount == 1)
+                ++counters.firstMoveCutoffs;
+            if (isQuiet(move))
+                context.addKiller(ply, move);
+            tt->store(key, depth, scoreToTT(beta, ply), Bound::LOWER, &move);
+            return beta;
+        }
+        if (score > alpha) {
+            alpha = score;
+            bestMove = move;
+            haveBest = true;
+            context.updatePv(ply, move);
+        }
+    }
+
+    if (legalCount == 0)
+        return board.kingInCheck(side) ? -MATE_SCORE + ply : 0;
+
+    tt->store(key, depth, scoreToTT(alpha, ply),
+             alpha > originalAlpha ? Bound::EXACT : Bound::UPPER,
+             haveBest ? &bestMove : nullptr);
+
+    return alpha;
+}
+
+
+int Search::quiescence(Board& board, int alpha, int beta, int ply) {
+    SearchFrame& frame = context.frame(ply);
+    frame.pvLength = 0;   // the PV ends where captures start
+
+    ++counters.nodes;
+    ++counters.qnodes;
+    counters.selDepth = std::max(counters.selDepth, ply);
+    if (shouldStop())
+        return 0;
+
+    int standPat = evaluate(board, pawnTable);
+    frame.staticEval = standPat;
+    if (standPat >= beta || ply >= MAX_PLY)
+        return standPat;
+    if (standPat > alpha)
+        alpha = standPat;
+
+    // Only captures and promotions are searched past the horizon
+    Color side = board.getSideToMove();
+    MovePicker picker(board, nullptr, frame, context.arena, true);
+    Move& move = frame.move;
+
+    while (picker.next(move)) {
+        board.applyMove(move);
+        if (board.kingInCheck(side)) {
+            board.undoMove(move);
+            continue;
+        }
+
+        int score = -quiescence(board, -beta, -alpha, ply + 1);
+        board.undoMove(move);
+
+        if (stopped)
+            return 0;
+
+        if (score >= beta)
+            return beta;
+        if (score > alpha)
+            alpha = score;
+    }
+
+    return alpha;
+}
+
+
+void Search::orderMoves(const Board& board, std::vector<Move>& moves) const {
+    std::stable_sort(moves.begin(), moves.end(),
+        [&](const Move& a, const Move& b) {
+            return mvvLva(board, a) > mvvLva(board, b);
+        });
+}
+
+
+void Search::extendPv(Board board, std::vector<Move>& pv, int maxLength) const {
+    for (auto& m : pv)
+        board.applyMove(m);
+
+    while (static_cast<int>(pv.size()) < maxLength) {
+        // The table can loop back on itself through repetitions
+        if (board.repetitionCount() >= 1)
+            break;
+
+        TTEntry entry;
+        Move m;
+        if (!tt->probe(board.hashKey(), entry) || !entry.hasMove() ||
+            !board.lookupMove(entry.from, entry.to, m))
+            break;
+
+        Color side = board.getSideToMove();
+        board.applyMove(m);
+        if (board.kingInCheck(side))
+            break;
+
+        pv.push_back(m);
+    }
+}
+
+
+bool Search::shouldStop() {
+    if (stopped)
+        return true;
+
+    if (stopFlag && stopFlag->load(std::memory_order_relaxed)) {
+        stopped = true;
+        return true;
+    }
+
+    if (config.maxNodes != 0 && counters.nodes >= config.maxNodes) {
+        stopped = true;
+    }
+    else if (config.moveTimeMs != 0 && (counters.nodes & 1023) == 0) {
+        if (elapsedMs() >= config.moveTimeMs)
+            stopped = true;
+    }
+
+    return stopped;
+}
+
+
+double Search::elapsedMs() const {
+    auto elapsed = std::chrono::steady_clock::now() - startTime;
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
@@ -0,0 +1,62 @@
+#include <new>
+#include "SearchContext.h"
+
+Arena::Arena(size_t bytes)
+    : buffer(std::make_unique<unsigned char[]>(bytes)), capacity(bytes) {
+}
+
+
+void* Arena::allocateBytes(size_t bytes, size_t align) {
+    size_t start = (used + align - 1) & ~(align - 1);
+    if (start + bytes > capacity)
+        throw std::bad_alloc();
+
+    used = start + bytes;
+    if (used > peak)
+        peak = used;
+    return buffer.get() + start;
+}
+
+
+// A score per move at every ply is the worst case the pickers ask for
+SearchContext::SearchContext()
+    : arena(static_cast<size_t>(MAX_PLY + 1) * MAX_MOVES * sizeof(int) * 2),
+      frames(MAX_PLY + 2) {
+    for (auto& frame : frames)
+        frame.moves.reserve(MAX_MOVES);
+}
+
+
+void SearchContext::reset() {
+    for (auto& frame : frames) {
+        frame.pvLength = 0;
+        frame.killerCount = 0;
+        frame.staticEval = 0;
+    }
+    arena.release(0);
+}
+
+
+void SearchContext::updatePv(int ply, const Move& move) {
+    SearchFrame& here = frames[ply];
+    const SearchFrame& child = frames[ply + 1];
+
+    here.pv[0] = move;
+    for (int i = 0; i < child.pvLength; ++i)
+        here.pv[i + 1] = child.pv[i];
+    here.pvLength = child.pvLength + 1;
+}
+
+
+void SearchContext::addKiller(int ply, const Move& move) {
+    SearchFrame& frame = frames[ply];
+    if (frame.killerCount > 0 &&
+        frame.killers[0].from == move.from && frame.killers[0].to == move.to)
+        return;
+
+    // Newest first; the older one slides down
+    frame.killers[1] = frame.killers[0];
+    frame.killers[0] = move;
+    if (frame.killerCount < 2)
+        ++frame.killerCount;
+}
@@ -0,0 +1,129 @@
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include "Search.h"
+#include "SearchStats.h"
+
+SearchCounters SearchCounters::since(const SearchCounters& earlier) const {
+    SearchCounters delta = *this;
+    delta.nodes -= earlier.nodes;
+    delta.qnodes -= earlier.qnodes;
+    delta.betaCutoffs -= earlier.betaCutoffs;
+    delta.firstMoveCutoffs -= earlier.firstMoveCutoffs;
+    delta.ttProbes -= earlier.ttProbes;
+    delta.ttHits -= earlier.ttHits;
+    delta.ttCollisions -= earlier.ttCollisions;
+    delta.ttCutoffs -= earlier.ttCutoffs;
+    delta.nullMoveTries -= earlier.nullMoveTries;
+    delta.nullMoveCutoffs -= earlier.nullMoveCutoffs;
+    delta.futilityPrunes -= earlier.futilityPrunes;
+    delta.lmrReductions -= earlier.lmrReductions;
+    delta.lmrResearches -= earlier.lmrResearches;
+    delta.pvsResearches -= earlier.pvsResearches;
+    delta.aspirationResearches -= earlier.aspirationResearches;
+    return delta;
+}
+
+
+double SearchStats::effectiveBranchingFactor() const {
+    if (iterations.empty())
+        return 0.0;
+
+    uint64_t nodes = 0;
+    for (const auto& iteration : iterations)
+        nodes += iteration.counters.nodes;
+    return std::pow(static_cast<double>(nodes), 1.0 / iterations.back().depth);
+}
+
+
+double percent(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * part / whole : 0.0;
+}
+
+
+std::string uciScore(int score) {
+    if (std::abs(score) >= MATE_SCORE - MAX_PLY) {
+        int plies = MATE_SCORE - std::abs(score);
+        int moves = (plies + 1) / 2;
+        return "mate " + std::to_string(score > 0 ? moves : -moves);
+    }
+    return "cp " + std::to_string(score);
+}
+
+
+std::string uciStatsInfo(const SearchStats& stats) {
+    if (stats.iterations.empty())
+        return "info string no completed iteration";
+
+    const IterationStats& last = stats.iterations.back();
+    const SearchCounters& c = last.counters;
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1)
+        << "info string depth " << last.depth
+        << " nodes " << c.nodes
+        << " qnodes " << percent(c.qnodes, c.nodes) << "%"
+        << " ebf " << std::setprecision(2) << last.branchingFactor << std::setprecision(1)
+        << " firstcut " << percent(c.firstMoveCutoffs, c.betaCutoffs) << "%"
+        << " tthit " << percent(c.ttHits, c.ttProbes) << "%"
+        << " ttcollision " << percent(c.ttCollisions, c.ttProbes) << "%"
+        << " ttcut " << c.ttCutoffs
+        << " nullcut " << percent(c.nullMoveCutoffs, c.nullMoveTries) << "%"
+        << " lmr " << c.lmrReductions << "/" << c.lmrResearches
+        << " pvsre " << c.pvsResearches
+        << " futile " << c.futilityPrunes
+        << " aspre " << c.aspirationResearches
+        << " ms " << last.iterationMs;
+    return out.str();
+}
+
+
+namespace {
+
+void writeCounters(std::ostream& out, const SearchCounters& c, const char* indent) {
+    out << indent << "\"nodes\": " << c.nodes << ",\n"
+        << indent << "\"qnodes\": " << c.qnodes << ",\n"
+        << indent << "\"seldepth\": " << c.selDepth << ",\n"
+        << indent << "\"beta_cutoffs\": " << c.betaCutoffs << ",\n"
+        << indent << "\"first_move_cutoffs\": " << c.firstMoveCutoffs << ",\n"
+        << indent << "\"first_move_cutoff_rate\": " << percent(c.firstMoveCutoffs, c.betaCutoffs) / 100 << ",\n"
+        << indent << "\"tt_probes\": " << c.ttProbes << ",\n"
+        << indent << "\"tt_hits\": " << c.ttHits << ",\n"
+        << indent << "\"tt_hit_rate\": " << percent(c.ttHits, c.ttProbes) / 100 << ",\n"
+        << indent << "\"tt_collisions\": " << c.ttCollisions << ",\n"
+        << indent << "\"tt_cutoffs\": " << c.ttCutoffs << ",\n"
+        << indent << "\"null_move_tries\": " << c.nullMoveTries << ",\n"
+        << indent << "\"null_move_cutoffs\": " << c.nullMoveCutoffs << ",\n"
+        << indent << "\"futility_prunes\": " << c.futilityPrunes << ",\n"
+        << indent << "\"lmr_reductions\": " << c.lmrReductions << ",\n"
+        << indent << "\"lmr_researches\": " << c.lmrResearches << ",\n"
+        << indent << "\"pvs_researches\": " << c.pvsResearches << ",\n"
+        << indent << "\"aspiration_researches\": " << c.aspirationResearches;
+}
+
+} // namespace
+
+
+void writeStatsJson(std::ostream& out, const SearchStats& stats) {
+    out << "{\n  \"time_ms\": " << stats.timeMs << ",\n"
+        << "  \"effective_branching_factor\": " << stats.effectiveBranchingFactor() << ",\n"
+        << "  \"total\": {\n";
+    writeCounters(out, stats.total, "    ");
+    out << "\n  },\n  \"iterations\": [";
+
+    for (size_t i = 0; i < stats.iterations.size(); ++i) {
+        const IterationStats& it = stats.iterations[i];
+        out << (i ? ",\n" : "\n")
+            << "    {\n"
+            << "      \"depth\": " << it.depth << ",\n"
+            << "      \"score\": " << it.score << ",\n"
+            << "      \"time_ms\": " << it.timeMs << ",\n"
+            << "      \"iteration_ms\": " << it.iterationMs << ",\n"
+            << "      \"branching_factor\": " << it.branchingFactor << ",\n";
+        writeCounters(out, it.counters, "      ");
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
@@ -0,0 +1,370 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include "Board.h"
+#include "TranspositionTable.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// ---------- SNAPSHOT FORMAT ----------
+// Native byte order; a snapshot from another byte order fails the magic.
+//   header, then `records` pairs of (key, packed data)
+// The version changes with the data layout. The key signature is the
+// start position's key, so snapshots made with other Zobrist keys are
+// refused instead of producing garbage hits.
+constexpr char snapshotMagic[8] = {'C', 'H', 'E', 'S', 'S', 'T', 'T', 0};
+constexpr uint32_t snapshotVersion = 1;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t keySignature;
+    uint64_t records;
+};
+
+struct SnapshotRecord {
+    uint64_t key;
+    uint64_t data;
+};
+
+uint64_t keySignature() {
+    return Board().hashKey();
+}
+
+// Read-only view of a whole file
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#if defined(_WIN32)
+        if (bytes) UnmapViewOfFile(bytes);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (bytes) munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+    }
+
+    bool open(const std::string& path) {
+#if defined(_WIN32)
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize))
+            return false;
+        length = static_cast<size_t>(fileSize.QuadPart);
+        if (length == 0)
+            return true;
+
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+            return false;
+        bytes = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        return bytes != nullptr;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            return false;
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length == 0) {
+            close(fd);
+            return true;
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED)
+            return false;
+
+        madvise(mapped, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const unsigned char*>(mapped);
+        return true;
+#endif
+    }
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+// Tables up to this size are set up on the calling thread; a Search
+// making its own small table shouldn't start threads for it
+constexpr size_t clearChunk = (64 * 1024 * 1024) / (2 * sizeof(uint64_t));
+
+} // namespace
+
+
+TranspositionTable::TranspositionTable(size_t megabytes) {
+    resize(megabytes);
+}
+
+
+void TranspositionTable::resize(size_t megabytes) {
+    count = floorPowerOfTwo((megabytes * 1024 * 1024) / sizeof(Slot));
+
+    memory = LargeBuffer(count * sizeof(Slot));
+    slots = static_cast<Slot*>(memory.data());
+    mask = count - 1;
+
+    // Constructing the slots is their first touch
+    parallelChunks(count, clearChunk, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            new (&slots[i]) Slot;
+    });
+}
+
+
+void TranspositionTable::clear() {
+    parallelChunks(count, clearChunk, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            slots[i].check.store(0, std::memory_order_relaxed);
+            slots[i].data.store(0, std::memory_order_relaxed);
+        }
+    });
+}
+
+
+// data layout: score 16 | depth 8 | bound 8 | from 8 | to 8
+uint64_t TranspositionTable::pack(const TTEntry& entry) {
+    return static_cast<uint64_t>(static_cast<uint16_t>(entry.score))
+         | static_cast<uint64_t>(static_cast<uint8_t>(entry.depth)) << 16
+         | static_cast<uint64_t>(entry.bound) << 24
+         | static_cast<uint64_t>(entry.from) << 32
+         | static_cast<uint64_t>(entry.to) << 40;
+}
+
+
+TTEntry TranspositionTable::unpack(uint64_t key, uint64_t data) {
+    TTEntry entry;
+    entry.key = key;
+    entry.score = static_cast<int16_t>(data & 0xFFFF);
+    entry.depth = static_cast<int8_t>((data >> 16) & 0xFF);
+    entry.bound = static_cast<Bound>((data >> 24) & 0xFF);
+    entry.from = static_cast<uint8_t>((data >> 32) & 0xFF);
+    entry.to = static_cast<uint8_t>((data >> 40) & 0xFF);
+    return entry;
+}
+
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const {
+    bool collision;
+    return probe(key, entry, collision);
+}
+
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry, bool& collision) const {
+    const Slot& slot = slots[key & mask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+
+    collision = false;
+    if (data == 0)
+        return false;
+    if ((check ^ data) != key) {
+        collision = true;
+        return false;
+    }
+
+    entry = unpack(key, data);
+    return entry.bound != Bound::NONE;
+}
+
+
+int TranspositionTable::hashfull() const {
+    size_t sample = std::min<size_t>(1000, count);
+    size_t used = 0;
+    for (size_t i = 0; i < sample; ++i)
+        used += slots[i].data.load(std::memory_order_relaxed) != 0;
+    return static_cast<int>(used * 1000 / sample);
+}
+
+
+void TranspositionTable::store(uint64_t key, int depth, int score, Bound bound, const Move* bestMove) {
+    Slot& slot = slots[key & mask];
+
+    TTEntry old;
+    bool samePosition = probe(key, old);
+    if (samePosition && depth < old.depth && bound != Bound::EXACT)
+        return;
+
+    TTEntry entry;
+    entry.score = static_cast<int16_t>(score);
+    entry.depth = static_cast<int8_t>(depth);
+    entry.bound = bound;
+
+    // Keep the old move when this search found none for the position
+    if (bestMove) {
+        entry.from = static_cast<uint8_t>(bestMove->from);
+        entry.to = static_cast<uint8_t>(bestMove->to);
+    } else if (samePosition) {
+        entry.from = old.from;
+        entry.to = old.to;
+    }
+
+    uint64_t data = pack(entry);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+
+// ---------- SNAPSHOTS ----------
+
+bool TranspositionTable::save(const std::string& path) const {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, snapshotMagic, sizeof(header.magic));
+    header.version = snapshotVersion;
+    header.recordSize = sizeof(SnapshotRecord);
+    header.keySignature = keySignature();
+
+    // Written next to the target and renamed, so a crash mid-write never
+    // leaves a truncated snapshot where the last good one was
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Error: could not write table snapshot " << temporary << std::endl;
+            return false;
+        }
+
+        // Records are streamed through a fixed buffer, so saving a table
+        // of several GB needs no second copy of it. The record count is
+        // only known at the end and patched into the header then.
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::array<SnapshotRecord, 4096> chunk;
+        size_t filled = 0;
+        auto flush = [&]() {
+            out.write(reinterpret_cast<const char*>(chunk.data()),
+                      static_cast<std::streamsize>(filled * sizeof(SnapshotRecord)));
+            header.records += filled;
+            filled = 0;
+        };
+
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t data = slots[i].data.load(std::memory_order_relaxed);
+            uint64_t check = slots[i].check.load(std::memory_order_relaxed);
+            if (data == 0)
+                continue;
+            chunk[filled++] = {check ^ data, data};
+            if (filled == chunk.size())
+                flush();
+        }
+        flush();
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!out) {
+            std::cerr << "Error: could not write table snapshot " << temporary << std::endl;
+            return false;
+        }
+    }
+
+#if defined(_WIN32)
+    std::remove(path.c_str());   // rename doesn't replace there
+#endif
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: could not replace table snapshot " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+bool TranspositionTable::load(const std::string& path) {
+    clear();
+    return merge(path);
+}
+
+
+bool TranspositionTable::merge(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Error: could not open table snapshot " << path << std::endl;
+        return false;
+    }
+
+    SnapshotHeader header;
+    if (file.size() < sizeof(header)) {
+        std::cerr << "Error: " << path << " is not a table snapshot" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, snapshotMagic, sizeof(header.magic)) != 0) {
+        std::cerr << "Error: " << path << " is not a table snapshot" << std::endl;
+        return false;
+    }
+    if (header.version != snapshotVersion || header.recordSize != sizeof(SnapshotRecord) ||
+        header.keySignature != keySignature()) {
+        std::cerr << "Error: table snapshot " << path << " was written by an incompatible version"
+                  << std::endl;
+        return false;
+    }
+    if (file.size() != sizeof(header) + header.records * sizeof(SnapshotRecord)) {
+        std::cerr << "Error: table snapshot " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    const unsigned char* records = file.data() + sizeof(header);
+    for (uint64_t i = 0; i < header.records; ++i) {
+        SnapshotRecord record;
+        std::memcpy(&record, records + i * sizeof(record), sizeof(record));
+        mergeEntry(record.key, record.data);
+    }
+    return true;
+}
+
+
+void TranspositionTable::mergeEntry(uint64_t key, uint64_t data) {
+    TTEntry incoming = unpack(key, data);
+    if (incoming.bound == Bound::NONE)
+        return;
+
+    // Whatever holds the slot, the deeper search is worth more
+    Slot& slot = slots[key & mask];
+    uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+    if (oldData != 0) {
+        uint64_t oldKey = slot.check.load(std::memory_order_relaxed) ^ oldData;
+        if (unpack(oldKey, oldData).depth > incoming.depth)
+            return;
+    }
+
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+}
@@ -1,31 +1,14 @@
 #include <iostream>
+#include <memory>
 #include <string>
-#include "Board.h"
-#include "Move.h"
+#include "MenuScene.h"
+#include "RenderScheduler.h"
+#include "Scene.h"
 #include <SFML/Graphics.hpp>
-#include <map>
 #include <stdexcept>
 
 
 
-enum class GameMode {
-    NONE,
-    FRIEND,
-    COMPUTER
-};
-
-enum class EndState {
-    NONE,
-    WHITE_WIN,
-    BLACK_WIN,
-    STALEMATE
-};
-
-GameMode runMenu();
-void runGameVsFriend();
-void runUnderDevelopmentWindow();
-
-
 /*
 int algebraicToSquare(const std::string& s) {
     int file = s[0] - 'a';   // a..h -> 0..7
@@ -115,513 +98,52 @@ int main() {
 
 
 
-constexpr int TILE_SIZE  = 128;
-constexpr int BOARD_SIZE = TILE_SIZE * 8;
-
-using PieceKey = std::pair<PieceType, Color>;
-
-
-// Convert board square (0–63) → pixel position
-sf::Vector2f squareToPixel(int square) {
-    int file = square % 8;
-    int rank = square / 8;
-
-    int flippedRank = 7 - rank;
-
-    return sf::Vector2f(
-        file * TILE_SIZE,
-        flippedRank * TILE_SIZE
-    );
-}
-
-
-
-int pixelToSquare(sf::Vector2i pos) {
-    if (pos.x < 0 || pos.y < 0) return -1;
-
-    int file = pos.x / TILE_SIZE;
-    int rank = 7 - (pos.y / TILE_SIZE);
-
-    if (file < 0 || file > 7 || rank < 0 || rank > 7)
-        return -1;
-
-    return rank * 8 + file;
-}
-
-
-
-
-// Load one piece texture
-void loadPiece(std::map<PieceKey, sf::Texture>& textures,
-               PieceType type,
-               Color color,
-               const std::string& path) {
-
-    sf::Texture tex;
-    if (!tex.loadFromFile(path)) {
-        throw std::runtime_error("Failed to load: " + path);
-    }
-    textures[{type, color}] = std::move(tex);
-}
-
-
-// Draw all pieces
-void drawPieces(sf::RenderWindow& window,
-                Board& board,
-                std::map<PieceKey, sf::Texture>& textures) {
-
-    for (int sq = 0; sq < 64; ++sq) {
-        Piece piece = board.getPiece(sq);
-        if (piece.type == PieceType::NONE) continue;
-
-        const sf::Texture& tex =
-            textures.at({piece.type, piece.color});
-
-        sf::Sprite sprite(tex);
-
-        sf::Vector2u size = tex.getSize();
-        float scaleX = TILE_SIZE / static_cast<float>(size.x);
-        float scaleY = TILE_SIZE / static_cast<float>(size.y);
-        sprite.setScale(sf::Vector2f(scaleX, scaleY));
-
-        sprite.setPosition(squareToPixel(sq));
-        window.draw(sprite);
-    }
-}
-
-
 int main() {
-    while (true) {
-        GameMode mode = runMenu();
-
-        if (mode == GameMode::FRIEND) {
-            runGameVsFriend();
-        }
-        else if (mode == GameMode::COMPUTER) {
-            runUnderDevelopmentWindow();
-        }
-        else {
-            break; // exit program
-        }
-    }
-
-    return 0;
-}
-
-
-GameMode runMenu() {
-    sf::RenderWindow menu(
-        sf::VideoMode({400, 300}),
-        "Chess - Menu",
-        sf::Style::Titlebar | sf::Style::Close
-    );
-
-    sf::Font font;
-    if (!font.openFromFile("fonts/font.ttf")) {
-        throw std::runtime_error("Failed to load font");
-    }
-
-    sf::Text title(font,"Chess", 36);
-    title.setPosition({150.f, 20.f});
-
-    sf::RectangleShape friendBtn({200, 50});
-    friendBtn.setPosition({100.f, 100.f});
-    friendBtn.setFillColor(sf::Color(200, 200, 200));
-
-    sf::RectangleShape computerBtn({200, 50});
-    computerBtn.setPosition({100.f, 170.f});
-    computerBtn.setFillColor(sf::Color(200, 200, 200));
-
-    sf::Text friendText(font, "Play vs Friend", 20);
-    friendText.setPosition({120.f, 110.f});
-    sf::Text computerText(font, "Play vs Computer", 20);
-    computerText.setPosition({105.f, 180.f});
-
-    while (menu.isOpen()) {
-        while (auto event = menu.pollEvent()) {
-            if (event->is<sf::Event::Closed>()) {
-                menu.close();
-                return GameMode::NONE;
-            }
-
-            if (const auto* mouse =
-                event->getIf<sf::Event::MouseButtonPressed>()) {
-
-                if (mouse->button == sf::Mouse::Button::Left) {
-                    sf::Vector2i mpos =
-                        sf::Mouse::getPosition(menu);
-
-                    if (friendBtn.getGlobalBounds().contains(
-                            sf::Vector2f{(float)mpos.x, (float)mpos.y})) {
-                        menu.close();
-                        return GameMode::FRIEND;
-                    }
-
-                    if (computerBtn.getGlobalBounds().contains(
-                            sf::Vector2f{(float)mpos.x, (float)mpos.y})) {
-                        menu.close();
-                        return GameMode::COMPUTER;
-                    }
-                }
-            }
-        }
-
-        menu.clear(sf::Color::White);
-        menu.draw(title);
-        menu.draw(friendBtn);
-        menu.draw(computerBtn);
-        menu.draw(friendText);
-        menu.draw(computerText);
-        menu.display();
-    }
-
-    return GameMode::NONE;
-}
-
-
-
-void runUnderDevelopmentWindow() {
-    sf::RenderWindow window(
-        sf::VideoMode({400, 200}),
-        "Under Development",
-        sf::Style::Titlebar | sf::Style::Close
-    );
-
-    sf::Font font;
-    if (!font.openFromFile("fonts/font.ttf")) {
-        throw std::runtime_error("Failed to load fonts/font.ttf");
-    }
-
-    sf::Text msg(
-        font,
-        "Computer opponent\nis under development",
-        22
-    );
-    msg.setPosition({40.f, 60.f});
-
-    while (window.isOpen()) {
-        while (auto event = window.pollEvent()) {
-            if (event->is<sf::Event::Closed>())
-                window.close();
-        }
-
-        window.clear(sf::Color::White);
-        window.draw(msg);
-        window.display();
-    }
-}
-
-
-
-void runGameVsFriend() {
     // ================= WINDOW =================
+    // One window for the whole session; menu, game and popups are scenes.
+    // The board takes the left 1024 pixels; the eval bar, analysis lines
+    // and move list share the rest.
     sf::RenderWindow window(
-        sf::VideoMode({1024, 1024}),
+        sf::VideoMode({1280, 1024}),
         "Chess",
         sf::Style::Titlebar | sf::Style::Close
     );
 
-    sf::Vector2u winSize = window.getSize();
-    const int TILE_SIZE = winSize.x / 8;
+    RenderScheduler scheduler(window);
 
-    Board board;
-    int selectedSquare = -1;
-
-    EndState endState = EndState::NONE;
-
-    std::vector<Move> selectedMoves;
-
-    // ================= BOARD =================
-    sf::Texture boardTexture;
-    if (!boardTexture.loadFromFile("images/board.png")) {
-        std::cerr << "Failed to load board.png\n";
-        return;
-    }
-
-    sf::Sprite boardSprite(boardTexture);
-    boardSprite.setScale(sf::Vector2f(
-        winSize.x / float(boardTexture.getSize().x),
-        winSize.y / float(boardTexture.getSize().y)
-    ));
-
-    // ================= PIECES =================
-    std::map<PieceKey, sf::Texture> pieceTextures;
-
-    loadPiece(pieceTextures, PieceType::PAWN,   Color::WHITE, "images/pieces/whitePawn.png");
-    loadPiece(pieceTextures, PieceType::KNIGHT, Color::WHITE, "images/pieces/whiteKnight.png");
-    loadPiece(pieceTextures, PieceType::BISHOP, Color::WHITE, "images/pieces/whiteBishop.png");
-    loadPiece(pieceTextures, PieceType::ROOK,   Color::WHITE, "images/pieces/whiteRook.png");
-    loadPiece(pieceTextures, PieceType::QUEEN,  Color::WHITE, "images/pieces/whiteQueen.png");
-    loadPiece(pieceTextures, PieceType::KING,   Color::WHITE, "images/pieces/whiteKing.png");
-
-    loadPiece(pieceTextures, PieceType::PAWN,   Color::BLACK, "images/pieces/blackPawn.png");
-    loadPiece(pieceTextures, PieceType::KNIGHT, Color::BLACK, "images/pieces/blackKnight.png");
-    loadPiece(pieceTextures, PieceType::BISHOP, Color::BLACK, "images/pieces/blackBishop.png");
-    loadPiece(pieceTextures, PieceType::ROOK,   Color::BLACK, "images/pieces/blackRook.png");
-    loadPiece(pieceTextures, PieceType::QUEEN,  Color::BLACK, "images/pieces/blackQueen.png");
-    loadPiece(pieceTextures, PieceType::KING,   Color::BLACK, "images/pieces/blackKing.png");
+    SceneStack scenes;
+    scenes.push(std::make_unique<MenuScene>(scenes, window.getSize()));
+    scenes.applyPending();
 
     // ================= MAIN LOOP =================
     while (window.isOpen()) {
 
         // -------- EVENTS --------
-        while (auto event = window.pollEvent()) {
-
+        while (auto event = scheduler.nextEvent()) {
             if (event->is<sf::Event::Closed>()) {
                 window.close();
+                break;
             }
-        // ---------- UNDO / REDO ----------
-        if (event->is<sf::Event::KeyPressed>()) {
-            auto key = event->getIf<sf::Event::KeyPressed>()->code;
-
-            if (key == sf::Keyboard::Key::Left && board.canUndo()) {
-                board.undoLastMove();
-
-                selectedSquare = -1;
-                selectedMoves.clear();
-                endState = EndState::NONE;
-            }
-            else if (key == sf::Keyboard::Key::Right && board.canRedo()) {
-                board.redoLastMove();
 
-                selectedSquare = -1;
-                selectedMoves.clear();
-                endState = EndState::NONE;
-            }
+            scenes.handleEvent(*event);
         }
 
-        // ---------- MOUSE INPUT ----------
-        if (endState == EndState::NONE) {
-            if (const auto* mouse =
-                    event->getIf<sf::Event::MouseButtonPressed>()) {
-
-                // your existing mouse move code
-            }
-        }
-            // --- POPUP BUTTON HANDLING ---
-            if (endState != EndState::NONE) {
-                if (const auto* mouse =
-                        event->getIf<sf::Event::MouseButtonReleased>()) {
-
-                    if (mouse->button == sf::Mouse::Button::Left) {
-                        sf::Vector2f mp(sf::Mouse::getPosition(window));
-
-                        // Recreate popup geometry (same as render)
-                        sf::RectangleShape popup({500.f, 300.f});
-                        popup.setPosition({
-                            winSize.x / 2.f - 250.f,
-                            winSize.y / 2.f - 150.f
-                        });
-
-                        sf::RectangleShape playAgainBtn({180.f, 50.f});
-                        sf::RectangleShape homeBtn({180.f, 50.f});
-
-                        playAgainBtn.setPosition({
-                            popup.getPosition().x + 60.f,
-                            popup.getPosition().y + 180.f
-                        });
-
-                        homeBtn.setPosition({
-                            popup.getPosition().x + 260.f,
-                            popup.getPosition().y + 180.f
-                        });
-
-                        if (playAgainBtn.getGlobalBounds().contains(mp)) {
-                            board = Board();
-    
-                            selectedSquare = -1;
-                            selectedMoves.clear();
-                            endState = EndState::NONE;
-                        }
-
-                        if (homeBtn.getGlobalBounds().contains(mp)) {
-                            window.close();
-                            return; // back to main()
-                        }
-                    }
-                }
-
-                continue; // IMPORTANT: block board input while popup is open
-            }
+        if (scenes.update())
+            scheduler.markDirty();
+        scheduler.setAnimating(scenes.isAnimating());
+        scheduler.setWakeInterval(scenes.wakeIntervalMs());
 
-            if (endState == EndState::NONE) {
-                if (const auto* mouse =
-                        event->getIf<sf::Event::MouseButtonPressed>()) {
-
-                    if (mouse->button == sf::Mouse::Button::Left) {
-
-                        sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-                        int clickedSquare = pixelToSquare(mousePos);
-                        if (clickedSquare == -1) continue;
-
-                        Piece clickedPiece = board.getPiece(clickedSquare);
-
-                        // ---- SELECT ----
-                        if (selectedSquare == -1) {
-                            if (clickedPiece.type != PieceType::NONE &&
-                                clickedPiece.color == board.getSideToMove()) {
-
-                                selectedSquare = clickedSquare;
-
-                                selectedMoves.clear();
-                                auto legal = board.legalMoves(board.getSideToMove());
-                                for (const auto& m : legal) {
-                                    if (m.from == selectedSquare) {
-                                        selectedMoves.push_back(m);
-                                    }
-                                }
-                            }
-                        }
-                        // ---- MOVE ----
-                        else {
-                            for (auto& m : selectedMoves) {   // <-- REMOVE const
-                                if (m.to == clickedSquare) {
-                                    board.makeMove(m);
-
-                                    if (board.isCheckmate(board.getSideToMove())) {
-                                        endState = (board.getSideToMove() == Color::WHITE)
-                                            ? EndState::BLACK_WIN
-                                            : EndState::WHITE_WIN;
-                                    }
-                                    else if (board.isStalemate(board.getSideToMove())) {
-                                        endState = EndState::STALEMATE;
-                                    }
-                                    break;
-                                }
-                            }
-
-
-                            selectedSquare = -1;
-                            selectedMoves.clear();
-                        }
-                    }
-                }
-            }
-        }
+        if (scenes.empty())
+            break;
 
         // -------- RENDER --------
-        window.clear();
-        window.draw(boardSprite);
-
-        // Highlight selected square
-        if (selectedSquare != -1) {
-            sf::RectangleShape highlight(
-                sf::Vector2f(TILE_SIZE, TILE_SIZE)
-            );
-            highlight.setFillColor(sf::Color(255, 255, 0, 100));
-            highlight.setPosition(squareToPixel(selectedSquare));
-            window.draw(highlight);
-        }
-
-        // Highlight available moves
-        for (auto& m : selectedMoves) {
-            sf::RectangleShape moveHighlight(
-                sf::Vector2f(TILE_SIZE, TILE_SIZE)
-            );
-
-            Piece target = board.getPiece(m.to);
-            if (target.type != PieceType::NONE) {
-                moveHighlight.setFillColor(sf::Color(255, 0, 0, 120));
-            } else {
-                moveHighlight.setFillColor(sf::Color(0, 255, 0, 120));
-            }
-
-            moveHighlight.setPosition(squareToPixel(m.to));
-            window.draw(moveHighlight);
-        }
-
-        // Draw pieces
-        for (int sq = 0; sq < 64; ++sq) {
-            Piece p = board.getPiece(sq);
-            if (p.type == PieceType::NONE) continue;
-
-            PieceKey key{ p.type, p.color };
-            sf::Sprite sprite(pieceTextures.at(key));
-
-            auto texSize = sprite.getTexture().getSize();
-            sprite.setScale(sf::Vector2f(
-                TILE_SIZE / float(texSize.x),
-                TILE_SIZE / float(texSize.y)
-            ));
-
-            sprite.setPosition(squareToPixel(sq));
-            window.draw(sprite);
-        }
-
-        if (endState != EndState::NONE) {
-            // --- Dark overlay ---
-            sf::RectangleShape overlay(
-                sf::Vector2f(winSize.x, winSize.y)
-            );
-            overlay.setFillColor(sf::Color(0, 0, 0, 150));
-            window.draw(overlay);
-
-            // --- Popup box ---
-            sf::RectangleShape popup({500.f, 300.f});
-            popup.setFillColor(sf::Color::White);
-            popup.setPosition({
-                winSize.x / 2.f - 250.f,
-                winSize.y / 2.f - 150.f
-            });
-            window.draw(popup);
-
-            // --- Text ---
-            sf::Font font;
-            if (!font.openFromFile("fonts/font.ttf")) {
-                std::cerr << "Failed to load font\n";
-            }
-
-            sf::Text msg(font, "", 36);
-            msg.setFillColor(sf::Color::Black);
-
-            if (endState == EndState::WHITE_WIN)
-                msg.setString("White wins!");
-            else if (endState == EndState::BLACK_WIN)
-                msg.setString("Black wins!");
-            else
-                msg.setString("Stalemate!");
-
-            msg.setPosition({
-                popup.getPosition().x + 130.f,
-                popup.getPosition().y + 40.f
-            });
-
-            window.draw(msg);
-
-            // --- Buttons ---
-            sf::RectangleShape playAgainBtn({180.f, 50.f});
-            sf::RectangleShape homeBtn({180.f, 50.f});
-
-            playAgainBtn.setPosition({
-                popup.getPosition().x + 60.f,
-                popup.getPosition().y + 180.f
-            });
-
-            homeBtn.setPosition({
-                popup.getPosition().x + 260.f,
-                popup.getPosition().y + 180.f
-            });
-
-            playAgainBtn.setFillColor(sf::Color(200, 200, 200));
-            homeBtn.setFillColor(sf::Color(200, 200, 200));
-
-            window.draw(playAgainBtn);
-            window.draw(homeBtn);
-
-            sf::Text playText(font, "Play Again", 20);
-            sf::Text homeText(font, "Home Screen", 20);
-
-            playText.setPosition(playAgainBtn.getPosition() + sf::Vector2f(20, 10));
-            homeText.setPosition(homeBtn.getPosition() + sf::Vector2f(20, 10));
-
-            window.draw(playText);
-            window.draw(homeText);
-
-            // --- Handle button clicks ---
-            
-        }
+        if (!scheduler.beginFrame())
+            continue;
 
+        window.clear(sf::Color::White);
+        scenes.draw(window);
         window.display();
     }
-    return;
-}
\ No newline at end of file
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <cstdint>
+#include <iostream>
+#include "Board.h"
+
+// Move generator regression test, run by ctest.
+//
+// Perft counts below are this generator's. Promotions are to a queen
+// only, so positions where a pawn can promote within the searched depth
+// count fewer nodes than the published tables; the rest match them.
+// Every node of a shallow walk from each position also checks that the
+// counting leaf path agrees with the move list it replaces, and castling
+// is checked to be a reversible move for the fifty-move clock.
+
+namespace {
+
+struct PerftCase {
+    const char* name;
+    const char* fen;
+    int depth;
+    uint64_t nodes;
+};
+
+const PerftCase cases[] = {
+    // Standard suite
+    {"startpos",   "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609},
+    {"kiwipete",   "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4074224},
+    {"position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 674624},
+    {"position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 320802},
+    {"position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 1806790},
+
+    // En passant
+    {"ep exposes own king",       "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1", 6, 1132035},
+    {"ep blocked by pin",         "8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1", 6, 1013750},
+    {"ep gives check",            "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1", 6, 1438912},
+    {"ep horizontal pin",         "8/8/8/8/k2Pp2Q/8/8/3K4 b - d3 0 1", 5, 117450},
+    {"ep horizontal pin, white",  "8/8/8/KPp4r/8/8/8/7k w - c6 0 1", 5, 22991},
+
+    // Castling
+    {"short castle gives check",  "5k2/8/8/8/8/8/8/4K2R w K - 0 1", 6, 661072},
+    {"long castle gives check",   "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", 6, 803711},
+    {"castling rights",           "r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1", 4, 1274206},
+    {"castling prevented",        "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1", 4, 1720476},
+
+    // Checks
+    {"discovered check",          "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1", 5, 963213},
+    {"double check",              "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1", 4, 23527},
+    {"self stalemate",            "K1k5/8/P7/8/8/8/8/8 w - - 0 1", 6, 1924},
+};
+
+// Number of nodes where countLegalMoves() disagreed with legalMoves()
+int checkCounts(Board& board, int depth) {
+    auto moves = board.legalMoves(board.getSideToMove());
+    int failures = board.countLegalMoves() == static_cast<int>(moves.size()) ? 0 : 1;
+    if (failures)
+        std::cerr << "Error: countLegalMoves " << board.countLegalMoves() << " != "
+                  << moves.size() << " at " << board.toFen() << std::endl;
+
+    if (depth > 0) {
+        for (auto m : moves) {
+            board.applyMove(m);
+            failures += checkCounts(board, depth - 1);
+            board.undoMove(m);
+        }
+    }
+    return failures;
+}
+
+// Castling captures nothing and moves no pawn, so it counts towards the
+// fifty-move rule like any other quiet move
+int checkCastlingClock() {
+    struct Castle { const char* fen; int from; int to; };
+    const Castle castles[] = {
+        {"r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 37 1", 4, 6},
+        {"r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 37 1", 4, 2},
+        {"r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 37 1", 60, 62},
+        {"r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 37 1", 60, 58},
+    };
+
+    int failures = 0;
+    for (const auto& c : castles) {
+        Board board;
+        Move m;
+        if (!board.loadFen(c.fen) || !board.lookupMove(c.from, c.to, m) || !m.castling) {
+            std::cerr << "Error: no castling move " << c.from << "-" << c.to
+                      << " in " << c.fen << std::endl;
+            ++failures;
+            continue;
+        }
+
+        board.applyMove(m);
+        bool ok = board.getHalfmoveClock() == 38 && m.captured.type == PieceType::NONE;
+        std::cout << (ok ? "ok    " : "FAIL  ") << "castling " << c.from << "-" << c.to
+                  << ": halfmove clock " << board.getHalfmoveClock() << "\n";
+        if (!ok)
+            ++failures;
+    }
+    return failures;
+}
+
+} // namespace
+
+
+int main() {
+    int failures = 0;
+
+    for (const auto& c : cases) {
+        Board board;
+        if (!board.loadFen(c.fen)) {
+            std::cerr << "Error: cannot load " << c.name << std::endl;
+            ++failures;
+            continue;
+        }
+
+        uint64_t nodes = board.perft(c.depth);
+        bool ok = nodes == c.nodes;
+        std::cout << (ok ? "ok    " : "FAIL  ") << c.name << ": perft " << c.depth
+                  << " = " << nodes;
+        if (!ok)
+            std::cout << ", expected " << c.nodes;
+        std::cout << "\n";
+        if (!ok)
+            ++failures;
+
+        failures += checkCounts(board, 3);
+    }
+
+    failures += checkCastlingClock();
+
+    std::cout << (failures ? "FAILED" : "passed") << std::endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "TranspositionTable.h"
+
+// Microbenchmarks for the Board primitives over a fixed set of positions.
+// Every benchmark is warmed up, then timed as a series of samples; the
+// report gives ns per operation as median and percentiles across samples.
+//
+//   chess_bench [--samples N] [--sample-ms MS] [--filter NAME] [--hash MB]
+//
+// With --hash, a transposition table of that size is built first: the
+// report says which pages it got and how long construction and clearing
+// took, and a random-probe benchmark is added.
+
+namespace {
+
+const char* const corpus[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r1bq1rk1/pp2nppp/2n1p3/3pP3/1b1P4/2NB1N2/PP3PPP/R1BQK2R w KQ - 0 9",
+    "2r3k1/5pp1/p3p2p/1p1nP3/3P4/P4N1P/1P3PP1/2R3K1 b - - 0 28",
+    "8/8/4k3/3p4/3P4/4K3/8/8 w - - 0 1",
+    "6k1/5ppp/8/8/8/8/q4PPP/1R4K1 b - - 0 1",
+};
+
+struct Benchmark {
+    std::string name;
+    std::function<uint64_t()> run;   // one pass, returns operations done
+};
+
+struct Stats {
+    double median;
+    double p10;
+    double p90;
+    double min;
+};
+
+// Keeps results observable so the work is not optimised away
+volatile uint64_t sink = 0;
+
+double percentile(const std::vector<double>& sorted, double q) {
+    size_t index = static_cast<size_t>(q * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+Stats measure(const Benchmark& bench, int samples, double sampleMs) {
+    using clock = std::chrono::steady_clock;
+
+    // Warm up caches and branch predictors, and size the sample so it
+    // runs for about sampleMs
+    uint64_t passes = 1;
+    while (true) {
+        auto start = clock::now();
+        for (uint64_t i = 0; i < passes; ++i)
+            bench.run();
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        if (ms >= sampleMs)
+            break;
+        passes *= 2;
+    }
+
+    std::vector<double> nsPerOp;
+    nsPerOp.reserve(samples);
+
+    for (int s = 0; s < samples; ++s) {
+        uint64_t ops = 0;
+        auto start = clock::now();
+        for (uint64_t i = 0; i < passes; ++i)
+            ops += bench.run();
+        double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        nsPerOp.push_back(ops ? ns / ops : 0.0);
+    }
+
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+    return {percentile(nsPerOp, 0.5), percentile(nsPerOp, 0.1),
+            percentile(nsPerOp, 0.9), nsPerOp.front()};
+}
+
+void printUsage() {
+    std::cout <<
+        "Usage: chess_bench [options]\n"
+        "  --samples N      timed samples per benchmark (default 25)\n"
+        "  --sample-ms MS   target length of one sample (default 20)\n"
+        "  --filter NAME    only run benchmarks whose name contains NAME\n"
+        "  --hash MB        also build and probe a transposition table\n";
+}
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    int samples = 25;
+    double sampleMs = 20.0;
+    std::string filter;
+    size_t hashMb = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " needs a value" << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--samples")        samples = std::max(1, std::atoi(next()));
+        else if (arg == "--sample-ms") sampleMs = std::atof(next());
+        else if (arg == "--filter")    filter = next();
+        else if (arg == "--hash")      hashMb = std::strtoull(next(), nullptr, 10);
+        else if (arg == "--help") {
+            printUsage();
+            return 0;
+        }
+        else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    // ---------- CORPUS ----------
+    std::vector<Board> boards;
+    for (const char* fen : corpus) {
+        Board board;
+        if (!board.loadFen(fen))
+            return 1;
+        boards.push_back(board);
+    }
+
+    std::vector<std::vector<Move>> moves;
+    for (auto board : boards)
+        moves.push_back(board.legalMoves(board.getSideToMove()));
+
+    // legalMoves fills the attack map cache; each op starts from a fresh
+    // copy so it pays for the maps as it would at a new perft node
+    std::vector<Board> scratch = boards;
+
+    // ---------- BENCHMARKS ----------
+    std::vector<Benchmark> benches = {
+        {"pseudoLegalMoves", [&]() -> uint64_t {
+            for (const auto& board : boards)
+                sink += board.pseudoLegalMoves(board.getSideToMove()).size();
+            return boards.size();
+        }},
+        {"legalMoves", [&]() -> uint64_t {
+            for (size_t i = 0; i < boards.size(); ++i) {
+                scratch[i] = boards[i];
+                sink += scratch[i].legalMoves(scratch[i].getSideToMove()).size();
+            }
+            return boards.size();
+        }},
+        {"squareAttacked", [&]() -> uint64_t {
+            uint64_t hits = 0;
+            for (const auto& board : boards) {
+                for (int sq = 0; sq < 64; ++sq) {
+                    hits += board.squareAttacked(sq, Color::WHITE);
+                    hits += board.squareAttacked(sq, Color::BLACK);
+                }
+            }
+            sink += hits;
+            return boards.size() * 128;
+        }},
+        {"kingInCheck", [&]() -> uint64_t {
+            uint64_t checks = 0;
+            for (const auto& board : boards) {
+                checks += board.kingInCheck(Color::WHITE);
+                checks += board.kingInCheck(Color::BLACK);
+            }
+            sink += checks;
+            return boards.size() * 2;
+        }},
+        {"applyMove+undoMove", [&]() -> uint64_t {
+            uint64_t ops = 0;
+            for (size_t i = 0; i < scratch.size(); ++i) {
+                for (auto move : moves[i]) {
+                    scratch[i].applyMove(move);
+                    scratch[i].undoMove(move);
+                }
+                sink += scratch[i].hashKey();
+                ops += moves[i].size();
+            }
+            return ops;
+        }},
+        {"Board copy", [&]() -> uint64_t {
+            for (size_t i = 0; i < boards.size(); ++i) {
+                scratch[i] = boards[i];
+                sink += scratch[i].hashKey();
+            }
+            return boards.size();
+        }},
+    };
+
+    // ---------- HASH TABLE ----------
+    std::unique_ptr<TranspositionTable> table;
+    if (hashMb > 0) {
+        using clock = std::chrono::steady_clock;
+
+        auto start = clock::now();
+        table = std::make_unique<TranspositionTable>(hashMb);
+        double buildMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        start = clock::now();
+        table->clear();
+        double clearMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        std::cout << "hash: " << table->memoryReport() << "\n"
+                  << std::fixed << std::setprecision(1)
+                  << "hash: built in " << buildMs << " ms, cleared in " << clearMs << " ms\n\n";
+
+        // Scattered keys, so nearly every probe is a cache and TLB miss
+        benches.push_back({"tt probe", [&]() -> uint64_t {
+            uint64_t key = sink;
+            uint64_t found = 0;
+            TTEntry entry;
+            for (int i = 0; i < 4096; ++i) {
+                key = key * 6364136223846793005ULL + 1442695040888963407ULL;
+                found += table->probe(key, entry);
+            }
+            sink += found;
+            return 4096;
+        }});
+    }
+
+    // ---------- REPORT ----------
+    std::cout << std::left << std::setw(22) << "benchmark"
+              << std::right << std::setw(12) << "median ns"
+              << std::setw(12) << "p10"
+              << std::setw(12) << "p90"
+              << std::setw(12) << "min" << "\n";
+
+    for (const auto& bench : benches) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos)
+            continue;
+
+        Stats stats = measure(bench, samples, sampleMs);
+
+        std::cout << std::left << std::setw(22) << bench.name
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << stats.median
+                  << std::setw(12) << stats.p10
+                  << std::setw(12) << stats.p90
+                  << std::setw(12) << stats.min << std::endl;
+    }
+
+    return 0;
+}
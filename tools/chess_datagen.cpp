@@ -0,0 +1,70 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "DataGen.h"
+
+// Self-play training data generator.
+//
+//   chess_datagen --out data --positions 1000000 --depth 4
+//                 [--nodes N] [--threads N] [--random-plies N] [--min-ply N]
+//                 [--sample-rate R] [--maxplies N] [--seed S]
+
+namespace {
+
+void printUsage() {
+    std::cout <<
+        "Usage: chess_datagen [options]\n"
+        "  --out PREFIX        shard prefix, writes PREFIX_<thread>.bin\n"
+        "  --positions N       total positions to write\n"
+        "  --depth N           search depth per move\n"
+        "  --nodes N           node limit per move\n"
+        "  --threads N         worker threads (default: all cores)\n"
+        "  --random-plies N    random opening moves per game\n"
+        "  --min-ply N         first ply that may be sampled\n"
+        "  --sample-rate R     fraction of quiet positions kept\n"
+        "  --maxplies N        adjudicate as draw after N plies\n"
+        "  --seed S            base random seed\n";
+}
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    DataGenConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " needs a value" << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--out")               config.outputPrefix = next();
+        else if (arg == "--positions")    config.positions = std::strtoull(next(), nullptr, 10);
+        else if (arg == "--depth")        config.search.maxDepth = std::atoi(next());
+        else if (arg == "--nodes")        config.search.maxNodes = std::strtoull(next(), nullptr, 10);
+        else if (arg == "--threads")      config.threads = std::atoi(next());
+        else if (arg == "--random-plies") config.randomPlies = std::atoi(next());
+        else if (arg == "--min-ply")      config.minPly = std::atoi(next());
+        else if (arg == "--sample-rate")  config.sampleRate = std::atof(next());
+        else if (arg == "--maxplies")     config.maxPlies = std::atoi(next());
+        else if (arg == "--seed")         config.seed = std::strtoull(next(), nullptr, 10);
+        else if (arg == "--help") {
+            printUsage();
+            return 0;
+        }
+        else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    DataGenerator generator(config);
+    generator.run();
+
+    return generator.ok() ? 0 : 1;
+}
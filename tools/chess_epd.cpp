@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "EpdSolver.h"
+
+// Tactical test suites: searches every position of each EPD suite to the
+// time limit and reports how many were solved within each shorter limit,
+// from the time the expected move became and stayed best.
+//
+//   chess_epd wac.epd [more.epd ...] [--time MS] [--threads N] [--smp]
+//             [--hash MB] [--limits 100,500,1000]
+
+namespace {
+
+void printUsage() {
+    std::cout <<
+        "Usage: chess_epd SUITE.epd [SUITE.epd ...] [options]\n"
+        "  --time MS          search time per position (default 1000)\n"
+        "  --threads N        worker threads (default: all cores)\n"
+        "  --smp              all threads on one position at a time\n"
+        "  --hash MB          table size per position (default 64)\n"
+        "  --limits A,B,...   report limits in ms (default: doubling from 100)\n";
+}
+
+std::vector<int> parseLimits(const std::string& text) {
+    std::vector<int> limits;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ','))
+        limits.push_back(std::atoi(item.c_str()));
+    return limits;
+}
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    EpdConfig config;
+    std::vector<std::string> suites;
+    std::vector<int> limits;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " needs a value" << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--time")           config.timeMs = std::atoi(next());
+        else if (arg == "--threads")   config.threads = std::atoi(next());
+        else if (arg == "--smp")       config.smp = true;
+        else if (arg == "--hash")      config.hashMb = std::atoi(next());
+        else if (arg == "--limits")    limits = parseLimits(next());
+        else if (arg == "--help") {
+            printUsage();
+            return 0;
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+        else {
+            suites.push_back(arg);
+        }
+    }
+
+    if (suites.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    if (limits.empty()) {
+        for (int limit = 100; limit < config.timeMs; limit *= 2)
+            limits.push_back(limit);
+        limits.push_back(config.timeMs);
+    }
+    std::sort(limits.begin(), limits.end());
+
+    EpdSolver solver(config);
+    for (const auto& suite : suites) {
+        auto positions = loadEpd(suite);
+        if (positions.empty()) {
+            std::cerr << "Error: no bm/am positions in " << suite << std::endl;
+            return 1;
+        }
+
+        auto results = solver.solve(positions);
+        EpdSolver::printSummary(std::cout, suite, positions, results, limits);
+    }
+
+    return 0;
+}
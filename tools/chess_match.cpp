@@ -0,0 +1,116 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "Match.h"
+#include "Profiler.h"
+
+// Headless self-play match between two engine configurations.
+//
+//   chess_match --book openings.epd --games 2000 --depth1 4 --depth2 3
+//               [--nodes1 N] [--nodes2 N] [--time1 ms] [--time2 ms]
+//               [--threads N] [--maxplies N] [--off1 FEATURE] [--off2 FEATURE]
+//               [--elo0 0] [--elo1 5] [--alpha 0.05] [--beta 0.05] [--no-sprt]
+//               [--profile-json FILE]
+
+namespace {
+
+void printUsage() {
+    std::cout <<
+        "Usage: chess_match [options]\n"
+        "  --book FILE        EPD/FEN openings, one per line\n"
+        "  --games N          total games (rounded up to pairs)\n"
+        "  --threads N        worker threads (default: all cores)\n"
+        "  --maxplies N       adjudicate as draw after N plies\n"
+        "  --depth1/--depth2 N, --nodes1/--nodes2 N, --time1/--time2 MS\n"
+        "                     limits for engine 1 and engine 2\n"
+        "  --noqs1/--noqs2    disable quiescence for an engine\n"
+        "  --off1/--off2 FEATURE  disable aspiration, pvs, nullmove, lmr or\n"
+        "                     futility for an engine (repeatable)\n"
+        "  --elo0 E --elo1 E --alpha A --beta B   SPRT bounds\n"
+        "  --no-sprt          play all games\n"
+        "  --profile-json FILE  write the profile counters as JSON\n";
+}
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    MatchConfig config;
+    config.engines[0].maxDepth = 3;
+    config.engines[1].maxDepth = 3;
+
+    std::string book;
+    std::string profileJson;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " needs a value" << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--book")           book = next();
+        else if (arg == "--games")     config.games = std::atoi(next());
+        else if (arg == "--threads")   config.threads = std::atoi(next());
+        else if (arg == "--maxplies")  config.maxPlies = std::atoi(next());
+        else if (arg == "--depth1")    config.engines[0].maxDepth = std::atoi(next());
+        else if (arg == "--depth2")    config.engines[1].maxDepth = std::atoi(next());
+        else if (arg == "--nodes1")    config.engines[0].maxNodes = std::strtoull(next(), nullptr, 10);
+        else if (arg == "--nodes2")    config.engines[1].maxNodes = std::strtoull(next(), nullptr, 10);
+        else if (arg == "--time1")     config.engines[0].moveTimeMs = std::atoi(next());
+        else if (arg == "--time2")     config.engines[1].moveTimeMs = std::atoi(next());
+        else if (arg == "--noqs1")     config.engines[0].quiescence = false;
+        else if (arg == "--noqs2")     config.engines[1].quiescence = false;
+        else if (arg == "--off1" || arg == "--off2") {
+            std::string feature = next();
+            if (!disableSearchFeature(config.engines[arg == "--off1" ? 0 : 1], feature)) {
+                std::cerr << "Error: unknown search feature " << feature << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--elo0")      config.sprt.elo0 = std::atof(next());
+        else if (arg == "--elo1")      config.sprt.elo1 = std::atof(next());
+        else if (arg == "--alpha")     config.sprt.alpha = std::atof(next());
+        else if (arg == "--beta")      config.sprt.beta = std::atof(next());
+        else if (arg == "--no-sprt")   config.sprt.enabled = false;
+        else if (arg == "--profile-json") profileJson = next();
+        else if (arg == "--help") {
+            printUsage();
+            return 0;
+        }
+        else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (!book.empty()) {
+        config.openings = loadOpenings(book);
+        if (config.openings.empty()) {
+            std::cerr << "Error: no openings found in " << book << std::endl;
+            return 1;
+        }
+    }
+
+    MatchRunner runner(config);
+    runner.run();
+
+    if (profile::enabled())
+        profile::printReport(std::cout);
+
+    if (!profileJson.empty()) {
+        std::ofstream out(profileJson);
+        if (!out) {
+            std::cerr << "Error: cannot write " << profileJson << std::endl;
+            return 1;
+        }
+        profile::writeJson(out);
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Board.h"
+#include "PerftShards.h"
+#include "Profiler.h"
+
+// Move generator node counts, with the hot-path profile when the build
+// has CHESS_PROFILE enabled.
+//
+//   chess_perft --depth 5 [--fen FEN] [--divide] [--profile-json FILE]
+//
+// With --split-ply the tree is cut into subtrees that run as separate
+// chess_perft processes, and the result is printed in --divide format:
+//
+//   chess_perft --depth 8 --split-ply 2 --workers 16 --journal run.journal
+//   chess_perft --depth 9 --split-ply 3 --journal run.journal
+//               --worker-cmd "ssh box1 chess_perft" --worker-cmd "ssh box2 chess_perft"
+//
+// Rerunning an interrupted command with the same journal resumes it.
+
+namespace {
+
+void printUsage() {
+    std::cout <<
+        "Usage: chess_perft [options]\n"
+        "  --depth N            perft depth (default 5)\n"
+        "  --fen FEN            start position (default: initial position)\n"
+        "  --divide             print the node count below each root move\n"
+        "  --profile-json FILE  write the profile counters as JSON\n"
+        "  --split-ply N        run the subtrees N plies down in worker processes\n"
+        "  --workers N          local worker processes (default: all cores)\n"
+        "  --worker-cmd CMD     command starting one worker, repeatable;\n"
+        "                       replaces the local workers\n"
+        "  --journal FILE       record finished subtrees here and resume from it\n";
+}
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    int depth = 5;
+    bool divide = false;
+    std::string fen;
+    std::string profileJson;
+
+    int splitPly = 0;
+    int localWorkers = static_cast<int>(std::thread::hardware_concurrency());
+    std::vector<std::string> workerCommands;
+    std::string journal;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " needs a value" << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--depth")              depth = std::atoi(next());
+        else if (arg == "--fen")           fen = next();
+        else if (arg == "--divide")        divide = true;
+        else if (arg == "--profile-json")  profileJson = next();
+        else if (arg == "--split-ply")     splitPly = std::atoi(next());
+        else if (arg == "--workers")       localWorkers = std::atoi(next());
+        else if (arg == "--worker-cmd")    workerCommands.push_back(next());
+        else if (arg == "--journal")       journal = next();
+        else if (arg == "--help") {
+            printUsage();
+            return 0;
+        }
+        else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t nodes = 0;
+
+    if (splitPly > 0) {
+        // Local workers are more copies of this binary
+        if (workerCommands.empty())
+            workerCommands.assign(std::max(1, localWorkers), "\"" + std::string(argv[0]) + "\"");
+
+        PerftShardConfig config;
+        config.fen = fen;
+        config.depth = depth;
+        config.splitPly = splitPly;
+        config.workers = workerCommands;
+        config.journal = journal;
+
+        ShardedPerft perft(config);
+        if (!perft.run())
+            return 1;
+
+        perft.printDivide(std::cout);
+        nodes = perft.total();
+    } else {
+        Board board;
+        if (!fen.empty() && !board.loadFen(fen))
+            return 1;
+
+        nodes = divide ? board.perftDivide(depth) : board.perft(depth);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Nodes: " << nodes << "\n"
+              << "Time:  " << seconds << " s\n"
+              << "NPS:   " << static_cast<uint64_t>(seconds > 0 ? nodes / seconds : 0) << "\n";
+
+    if (profile::enabled())
+        profile::printReport(std::cout);
+
+    if (!profileJson.empty()) {
+        std::ofstream out(profileJson);
+        if (!out) {
+            std::cerr << "Error: cannot write " << profileJson << std::endl;
+            return 1;
+        }
+        profile::writeJson(out);
+    }
+
+    return 0;
+}
@@ -0,0 +1,309 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "Board.h"
+#include "Search.h"
+#include "SearchStats.h"
+
+// UCI front end for the search, for GUIs and tournament managers. Each
+// completed iteration is reported in info lines, one per multi-PV line,
+// followed by an "info string" with the search statistics of that
+// iteration. With --stats-json the statistics of the last search are
+// also written to a file when it finishes.
+//
+//   chess_uci [--stats-json FILE]
+
+namespace {
+
+// Selectivity switches, offered as check options for A/B testing
+const char* const searchFeatures[] = {"aspiration", "pvs", "nullmove", "lmr", "futility"};
+
+std::mutex outputMutex;
+
+void send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::cout << line << std::endl;
+}
+
+std::string uciMove(const Move& m) {
+    std::string text{static_cast<char>('a' + m.from % 8), static_cast<char>('1' + m.from / 8),
+                     static_cast<char>('a' + m.to % 8), static_cast<char>('1' + m.to / 8)};
+    if (m.promotion)
+        text += 'q';
+    return text;
+}
+
+// Long algebraic ("e2e4", "e7e8q"), legal in the position
+bool parseUciMove(Board& board, const std::string& text, Move& move) {
+    if (text.size() < 4 || text.size() > 5)
+        return false;
+
+    int from = (text[1] - '1') * 8 + (text[0] - 'a');
+    int to = (text[3] - '1') * 8 + (text[2] - 'a');
+    if (!board.lookupMove(from, to, move))
+        return false;
+    if (move.promotion != (text.size() == 5) || (move.promotion && text[4] != 'q'))
+        return false;
+
+    Color side = board.getSideToMove();
+    board.applyMove(move);
+    bool legal = !board.kingInCheck(side);
+    board.undoMove(move);
+    return legal;
+}
+
+class Engine {
+public:
+    explicit Engine(std::string statsJson)
+        : table(std::make_shared<TranspositionTable>(config.hashMb)),
+          statsJson(std::move(statsJson)) {
+        config.maxDepth = MAX_PLY - 1;
+    }
+
+    ~Engine() { stopSearch(); }
+
+    void identify() const {
+        send("id name chess");
+        send("id author the chess developers");
+        send("option name Hash type spin default 16 min 1 max 65536");
+        send("option name MultiPV type spin default 1 min 1 max 64");
+        send("option name Clear Hash type button");
+        for (const char* feature : searchFeatures)
+            send(std::string("option name ") + feature + " type check default true");
+        send("uciok");
+    }
+
+    void newGame() {
+        stopSearch();
+        table->clear();
+        board = Board();
+    }
+
+    void setOption(std::istringstream& in) {
+        std::string token, name, value;
+        in >> token;   // "name"
+        while (in >> token && token != "value")
+            name += (name.empty() ? "" : " ") + token;
+        std::getline(in >> std::ws, value);
+
+        stopSearch();
+        if (name == "Hash")
+            table = std::make_shared<TranspositionTable>(std::max(1, std::atoi(value.c_str())));
+        else if (name == "MultiPV")
+            config.multiPv = std::max(1, std::atoi(value.c_str()));
+        else if (name == "Clear Hash")
+            table->clear();
+        else if (std::count(std::begin(searchFeatures), std::end(searchFeatures), name)) {
+            if (value == "false")
+                disabledFeatures.insert(name);
+            else
+                disabledFeatures.erase(name);
+        }
+        else
+            send("info string unknown option " + name);
+    }
+
+    void position(std::istringstream& in) {
+        stopSearch();
+
+        std::string token;
+        in >> token;
+
+        Board next;
+        if (token == "fen") {
+            std::string fen;
+            while (in >> token && token != "moves")
+                fen += (fen.empty() ? "" : " ") + token;
+            if (!next.loadFen(fen)) {
+                send("info string invalid fen " + fen);
+                return;
+            }
+        } else if (token == "startpos") {
+            in >> token;   // "moves", if any
+        } else {
+            return;
+        }
+
+        while (in >> token) {
+            Move move;
+            if (!parseUciMove(next, token, move)) {
+                send("info string illegal move " + token);
+                return;
+            }
+            next.applyMove(move);
+        }
+        board = next;
+    }
+
+    void go(std::istringstream& in) {
+        stopSearch();
+
+        SearchConfig searchConfig = config;
+        for (const auto& feature : disabledFeatures)
+            disableSearchFeature(searchConfig, feature);
+
+        bool infinite = false;
+        int times[2] = {0, 0};
+        int increments[2] = {0, 0};
+        int movesToGo = 0;
+
+        std::string token;
+        while (in >> token) {
+            if (token == "depth")          in >> searchConfig.maxDepth;
+            else if (token == "nodes")     in >> searchConfig.maxNodes;
+            else if (token == "movetime")  in >> searchConfig.moveTimeMs;
+            else if (token == "wtime")     in >> times[0];
+            else if (token == "btime")     in >> times[1];
+            else if (token == "winc")      in >> increments[0];
+            else if (token == "binc")      in >> increments[1];
+            else if (token == "movestogo") in >> movesToGo;
+            else if (token == "infinite")  infinite = true;
+        }
+
+        // A slice of the clock: the remaining time spread over the moves
+        // still to play, plus most of the increment
+        int side = static_cast<int>(board.getSideToMove());
+        if (times[side] > 0 && searchConfig.moveTimeMs == 0) {
+            int budget = times[side] / (movesToGo > 0 ? movesToGo + 1 : 30) + increments[side] * 3 / 4;
+            searchConfig.moveTimeMs = std::max(10, std::min(budget, times[side] - 50));
+        }
+        searchConfig.maxDepth = std::min(searchConfig.maxDepth, MAX_PLY - 1);
+
+        worker = std::thread([this, position = board, searchConfig, infinite]() {
+            search(position, searchConfig, infinite);
+        });
+    }
+
+    void stopSearch() {
+        stop = true;
+        if (worker.joinable())
+            worker.join();
+        stop = false;
+    }
+
+private:
+    void search(const Board& position, const SearchConfig& searchConfig, bool infinite) {
+        Search search(searchConfig, table);
+        search.setStopFlag(&stop);
+        search.setIterationCallback([&](const SearchResult& result) { report(result); });
+
+        SearchResult result = search.think(position);
+
+        // In infinite mode the GUI expects bestmove only after its stop
+        while (infinite && !stop)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        if (!statsJson.empty()) {
+            std::ofstream out(statsJson);
+            if (out)
+                writeStatsJson(out, result.stats);
+            else
+                send("info string cannot write " + statsJson);
+        }
+
+        std::string line = "bestmove " + (result.hasMove ? uciMove(result.bestMove) : "0000");
+        if (!result.lines.empty() && result.lines.front().pv.size() > 1)
+            line += " ponder " + uciMove(result.lines.front().pv[1]);
+        send(line);
+    }
+
+    void report(const SearchResult& result) const {
+        const SearchStats& stats = result.stats;
+        double ms = stats.timeMs;
+        uint64_t nps = ms > 0 ? static_cast<uint64_t>(result.nodes * 1000.0 / ms) : 0;
+        int hashfull = table->hashfull();
+
+        for (size_t i = 0; i < result.lines.size(); ++i) {
+            const SearchLine& line = result.lines[i];
+
+            std::ostringstream out;
+            out << "info depth " << result.depth
+                << " seldepth " << stats.total.selDepth
+                << " multipv " << i + 1
+                << " score " << uciScore(line.score)
+                << " nodes " << result.nodes
+                << " nps " << nps
+                << " hashfull " << hashfull
+                << " time " << static_cast<uint64_t>(ms)
+                << " pv";
+            for (const auto& m : line.pv)
+                out << " " << uciMove(m);
+            send(out.str());
+        }
+        send(uciStatsInfo(stats));
+    }
+
+    Board board;
+    SearchConfig config;
+    std::set<std::string> disabledFeatures;   // check options set to false
+    std::shared_ptr<TranspositionTable> table;
+    std::string statsJson;
+
+    std::thread worker;
+    std::atomic<bool> stop{false};
+};
+
+void printUsage() {
+    std::cout <<
+        "Usage: chess_uci [options]\n"
+        "  --stats-json FILE  write the statistics of each search as JSON\n";
+}
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    std::string statsJson;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " needs a value" << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--stats-json") statsJson = next();
+        else if (arg == "--help") {
+            printUsage();
+            return 0;
+        }
+        else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    Engine engine(statsJson);
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::string command;
+        in >> command;
+
+        if (command == "uci")             engine.identify();
+        else if (command == "isready")    send("readyok");
+        else if (command == "ucinewgame") engine.newGame();
+        else if (command == "setoption")  engine.setOption(in);
+        else if (command == "position")   engine.position(in);
+        else if (command == "go")         engine.go(in);
+        else if (command == "stop")       engine.stopSearch();
+        else if (command == "quit")       break;
+    }
+
+    return 0;
+}